@@ -6,5 +6,7 @@
 #include "../src/tls.h"
 #include "../src/await.h"
 #include "../src/chan.h"
+#include "../src/executor.h"
+#include "../src/co.h"
 
 #endif /* _FROST_API_H */
@@ -3,6 +3,7 @@
 
 #include <stdint.h>
 #include <stdarg.h>
+#include <stddef.h>
 
 #ifndef FROST_PORTED_LOG_PRINT
   static void __frost_log_print(const char* tag, const char* fmt, ...) {}
@@ -10,7 +11,13 @@
   extern void __frost_log_print(const char* tag, const char* fmt, ...);
 #endif
 
-#ifndef FROST_PORTED_TIME_TICK
+#if defined(FROST_PORT_TIME_HIRES)
+  /* built-in port reads the cycle counter (x86-64 with invariant TSC) or
+     CLOCK_MONOTONIC_RAW, calibrated once at frost_init(). see src/hires.c */
+  extern uint64_t __frost_time_tick(uint64_t* tick);
+  extern uint64_t __frost_time_ns();
+  extern void __frost_time_calibrate();
+#elif !defined(FROST_PORTED_TIME_TICK)
   #warning "the __frost_time_tick function is not ported, \
             this will cause a frozen execution! \
             please port this function in your application before using Frost."
@@ -19,4 +26,18 @@
   extern uint64_t __frost_time_tick(uint64_t* tick);
 #endif
 
+#if !defined(FROST_PORT_TIME_HIRES)
+  #ifdef FROST_PORTED_TIME_NS
+    extern uint64_t __frost_time_ns();
+  #else
+    /* the nanosecond clock is not ported, the profiling falls back to the tick resolution */
+    static inline uint64_t __frost_time_ns() { return __frost_time_tick(NULL) * 1000000ull; }
+  #endif
+#endif
+
+#ifdef FROST_PORTED_IDLE_PARK
+  extern void __frost_idle_park(uint64_t timeout);
+  extern void __frost_idle_wake();
+#endif
+
 #endif /* _FROST_PORT_H */
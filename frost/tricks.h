@@ -8,13 +8,13 @@
 #define run_async frost_task_run_ex
 
 /**
- * @brief await
+ * @brief await, a stackful task suspends until the awaiter finished
  */
 #define await awaiter_await
 
 /**
- * @brief yield
+ * @brief yield, a stackful task suspends until next schedule cycle
  */
-#define yield engine_schedule_tasks()
+#define yield frost_yield()
 
 #endif /* _SYS_TASK_TRICKS_H */
@@ -11,16 +11,27 @@
 
 #include "engine.h"
 #include "await.h"
+#include "executor.h"
 
-static frost_awaiter_t* awaiter_create_ex(bool is_finished,
+#ifdef FROST_HAS_ATOMICS
+  #include <stdatomic.h>
+#endif
+
+static frost_awaiter_t* awaiter_create_ex(slab_ctx_t* slab, bool is_finished,
 frost_handle_t result, frost_errcode_t status) {
 
+  void* _awaiter = NULL;
+
+  // take it from the slab of engine, or the system allocator
+  if(slab == NULL || !frost_ok(slab_alloc(slab, &_awaiter))) {
+    slab = NULL;
+    _awaiter = malloc(sizeof(frost_awaiter_t));
+  }
+
   // memory allocation failed.. nothing to do. oops
-  frost_handle_t _awaiter = malloc(sizeof(frost_awaiter_t)); {
-    if(_awaiter == NULL) {
-      frost_log(TAG, "memory allocation failed for task awaiter");
-      return NULL;
-    }
+  if(_awaiter == NULL) {
+    frost_log(TAG, "memory allocation failed for task awaiter");
+    return NULL;
   }
 
   // initialize awaiter
@@ -28,6 +39,15 @@ frost_handle_t result, frost_errcode_t status) {
     _awaiter_ptr->is_finished = is_finished;
     _awaiter_ptr->result = result;
     _awaiter_ptr->status = status;
+    _awaiter_ptr->timeout = 0;
+    _awaiter_ptr->is_bound = false;
+    _awaiter_ptr->is_resolved = false;
+    _awaiter_ptr->is_remote = false;
+    _awaiter_ptr->is_claimed = is_finished;
+    _awaiter_ptr->refs = 1;
+    _awaiter_ptr->resolved.result = NULL;
+    _awaiter_ptr->resolved.status = frost_err_ok;
+    _awaiter_ptr->slab = slab;
   }
 
   frost_log(TAG, "awaiter created %p", _awaiter_ptr);
@@ -36,11 +56,72 @@ frost_handle_t result, frost_errcode_t status) {
 }
 
 frost_awaiter_t* awaiter_from_value(frost_handle_t value, frost_errcode_t status) {
-  return awaiter_create_ex(true, value, status);
+  return awaiter_create_ex(NULL, true, value, status);
 }
 
 frost_awaiter_t* awaiter_create() {
-  return awaiter_create_ex(false, NULL, frost_err_ok);
+  return awaiter_create_ex(NULL, false, NULL, frost_err_ok);
+}
+
+frost_awaiter_t* awaiter_alloc(slab_ctx_t* slab) {
+  return awaiter_create_ex(slab, false, NULL, frost_err_ok);
+}
+
+/**
+ * @brief take the right to publish the result, only one side wins
+ *
+ * @param awaiter awaiter pointer
+ * @return true if the caller publishes it
+ */
+static bool __awaiter_claim(frost_awaiter_t* awaiter) {
+  #ifdef FROST_HAS_ATOMICS
+  return !atomic_exchange(&awaiter->is_claimed, true);
+  #else
+  if(awaiter->is_claimed) return false;
+  awaiter->is_claimed = true;
+  return true;
+  #endif
+}
+
+/**
+ * @brief drop a reference, the last one frees the awaiter
+ *
+ * @param awaiter awaiter pointer
+ */
+static void __awaiter_release(frost_awaiter_t* awaiter) {
+
+  #ifdef FROST_HAS_ATOMICS
+  if(atomic_fetch_sub(&awaiter->refs, 1) != 1)
+    return;
+  #else
+  if(--awaiter->refs != 0)
+    return;
+  #endif
+
+  frost_log(TAG, "awaiter destroyed %p", awaiter);
+
+  // the caller may be any thread, give it back to the owner of slab
+  if(awaiter->slab != NULL) slab_free_remote(awaiter->slab, awaiter);
+  else free(awaiter);
+}
+
+frost_awaiter_t* awaiter_abandon(frost_awaiter_t* awaiter, frost_errcode_t status) {
+
+  // the task is publishing its result, it's done in a moment
+  if(!__awaiter_claim(awaiter)) {
+    while(!awaiter->is_finished) idle_yield();
+    return awaiter;
+  }
+
+  awaiter->result = NULL;
+  awaiter->status = status;
+  awaiter->is_finished = true;
+  return awaiter;
+}
+
+void awaiter_bind(frost_awaiter_t* awaiter) {
+  awaiter->is_bound = true;
+  awaiter->refs = 2;
 }
 
 frost_errcode_t awaiter_destroy(frost_awaiter_t* awaiter) {
@@ -48,29 +129,88 @@ frost_errcode_t awaiter_destroy(frost_awaiter_t* awaiter) {
   if(awaiter == NULL)
     return frost_err_invalid_parameter;
 
-  frost_log(TAG, "awaiter destroyed %p", awaiter);
-  free(awaiter);
-
+  // the bound task frees it when it settles
+  __awaiter_release(awaiter);
   return frost_err_ok;
 }
 
+/**
+ * @brief wait an awaiter finished by the other thread,
+ * without driving the engine
+ *
+ * @param awaiter awaiter pointer
+ * @return frost_awaiter_t*
+ */
+static frost_awaiter_t* __awaiter_wait(frost_awaiter_t* awaiter) {
+
+  uint64_t _start = __frost_time_tick(NULL);
+  while(!awaiter->is_finished) {
+
+    // check if task timed out
+    if(awaiter->timeout != 0 &&
+      (__frost_time_tick(NULL) - _start >= awaiter->timeout)) {
+
+      frost_log(TAG, "task timed out, force to break");
+      return awaiter_abandon(awaiter, frost_err_task_timeout);
+    }
+
+    idle_yield();
+  }
+
+  return awaiter;
+}
+
+/**
+ * @brief suspend the stackful task until the awaiter finished,
+ * the scheduler resumes it every pass
+ *
+ * @param awaiter awaiter pointer
+ * @return frost_awaiter_t*
+ */
+static frost_awaiter_t* __awaiter_suspend(frost_awaiter_t* awaiter) {
+
+  uint64_t _start = __frost_time_tick(NULL);
+  while(!awaiter->is_finished) {
+
+    // check if task timed out
+    if(awaiter->timeout != 0 &&
+      (__frost_time_tick(NULL) - _start >= awaiter->timeout)) {
+
+      frost_log(TAG, "task timed out, force to break");
+      return awaiter_abandon(awaiter, frost_err_task_timeout);
+    }
+
+    frost_task_suspend(0);
+  }
+
+  return awaiter;
+}
+
 frost_awaiter_t* awaiter_await(frost_awaiter_t* awaiter) {
   
   if(awaiter == NULL)
     return awaiter_from_value(NULL, frost_err_invalid_parameter);
 
+  // a worker cannot drive the engine, run the executor tasks while waiting
+  if(executor_is_worker())
+    return executor_await(awaiter);
+
+  // a stackful task suspends instead of scheduling on top of itself
+  if(frost_task_can_suspend())
+    return __awaiter_suspend(awaiter);
+
+  // submitted from a foreign thread, the engine thread runs it
+  if(awaiter->is_remote)
+    return __awaiter_wait(awaiter);
+
   frost_engine_t* _engine;
   frost_errcode_t _result;
 
-  if(!frost_ok(_result = frost_get_engine(&_engine))) {
-    awaiter->status = frost_err_invalid_parameter;
-    awaiter->is_finished = true;
-    awaiter->result = NULL;
-    return awaiter;
-  }
+  if(!frost_ok(_result = frost_get_engine(&_engine)))
+    return awaiter_abandon(awaiter, frost_err_invalid_parameter);
 
   uint64_t _start = _engine->scheduler.tick;
-  while(frost_schedule_tasks() == frost_err_ok) {
+  while(frost_schedule_tasks_ex(_engine) == frost_err_ok) {
     
     // the task is finished
     if(awaiter->is_finished)
@@ -81,21 +221,13 @@ frost_awaiter_t* awaiter_await(frost_awaiter_t* awaiter) {
       (_engine->scheduler.tick- _start >= awaiter->timeout)) {
 
       frost_log(TAG, "task timed out, force to break");
-
-      awaiter->status = frost_err_task_timeout;
-      awaiter->is_finished = true;
-      awaiter->result = NULL;
-
-      return awaiter;
+      return awaiter_abandon(awaiter, frost_err_task_timeout);
     }
 
   }
 
-  frost_log(TAG, "awaiting task failure, frost_schedule_tasks() does not return frost_err_ok");
-  awaiter->status = frost_err_fatal_error;
-  awaiter->is_finished = true;
-  awaiter->result = NULL;
-  return awaiter;
+  frost_log(TAG, "awaiting task failure, frost_schedule_tasks_ex() does not return frost_err_ok");
+  return awaiter_abandon(awaiter, frost_err_fatal_error);
 }
 
 frost_errcode_t awaiter_finish(frost_awaiter_t* awaiter, frost_handle_t result) {
@@ -103,6 +235,17 @@ frost_errcode_t awaiter_finish(frost_awaiter_t* awaiter, frost_handle_t result)
   if(awaiter == NULL)
     return frost_err_invalid_parameter;
 
+  // the scheduler publishes it after the task returns
+  if(awaiter->is_bound) {
+    awaiter->resolved.result = result;
+    awaiter->resolved.status = frost_err_ok;
+    awaiter->is_resolved = true;
+    return frost_err_ok;
+  }
+
+  if(!__awaiter_claim(awaiter))
+    return frost_err_ok;
+
   awaiter->result = result;
   awaiter->status = frost_err_ok;
   awaiter->is_finished = true;
@@ -114,8 +257,45 @@ frost_errcode_t awaiter_cancel(frost_awaiter_t* awaiter) {
   if(awaiter == NULL)
     return frost_err_invalid_parameter;
 
+  // the scheduler publishes it after the task returns
+  if(awaiter->is_bound) {
+    awaiter->resolved.result = NULL;
+    awaiter->resolved.status = frost_err_task_canceled;
+    awaiter->is_resolved = true;
+    return frost_err_ok;
+  }
+
+  if(!__awaiter_claim(awaiter))
+    return frost_err_ok;
+
   awaiter->result = NULL;
   awaiter->status = frost_err_task_canceled;
   awaiter->is_finished = true;
   return frost_err_ok;
 }
+
+frost_errcode_t awaiter_settle(frost_awaiter_t* awaiter) {
+
+  if(awaiter == NULL)
+    return frost_err_invalid_parameter;
+
+  awaiter->is_bound = false;
+
+  // the waiter has not given up yet, publish the result
+  if(__awaiter_claim(awaiter)) {
+
+    if(!awaiter->is_resolved) {
+      frost_log(TAG, "awaiter is not finished, force marked as cancel state");
+      awaiter->resolved.result = NULL;
+      awaiter->resolved.status = frost_err_task_canceled;
+    }
+
+    awaiter->result = awaiter->resolved.result;
+    awaiter->status = awaiter->resolved.status;
+    awaiter->is_finished = true;
+  }
+
+  // the waiter may have destroyed it, the task frees it then
+  __awaiter_release(awaiter);
+  return frost_err_ok;
+}
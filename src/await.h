@@ -17,6 +17,15 @@
  */
 frost_awaiter_t* awaiter_create();
 
+/**
+ * @brief create an awaiter from the slab, or by malloc if slab is NULL or exhausted.
+ * the awaiter from slab is valid until the slab is destroyed
+ *
+ * @param slab the slab of frost_awaiter_t, owned by current thread
+ * @return frost_awaiter_t*
+ */
+frost_awaiter_t* awaiter_alloc(slab_ctx_t* slab);
+
 /**
  * @brief create an awaiter from value
  *
@@ -27,7 +36,15 @@ frost_awaiter_t* awaiter_create();
 frost_awaiter_t* awaiter_from_value(frost_handle_t value, frost_errcode_t status);
 
 /**
- * @brief awaiter destroy
+ * @brief bind an awaiter to a task, the task holds a reference until it settles
+ *
+ * @param awaiter awaiter pointer
+ */
+void awaiter_bind(frost_awaiter_t* awaiter);
+
+/**
+ * @brief awaiter destroy, safe to call from any thread.
+ * a still bound awaiter is freed when its task settles
  *
  * @param awaiter awaiter pointer
  * @return frost_errcode_t
@@ -42,6 +59,15 @@ frost_errcode_t awaiter_destroy(frost_awaiter_t* awaiter);
  */
 frost_awaiter_t* awaiter_await(frost_awaiter_t* awaiter);
 
+/**
+ * @brief give up waiting, publish the status unless the task has published its result
+ *
+ * @param awaiter awaiter pointer
+ * @param status the status of giving up
+ * @return frost_awaiter_t*
+ */
+frost_awaiter_t* awaiter_abandon(frost_awaiter_t* awaiter, frost_errcode_t status);
+
 /**
  * @brief set awaiter status to finish
  *
@@ -59,4 +85,14 @@ frost_errcode_t awaiter_finish(frost_awaiter_t* awaiter, frost_handle_t result);
  */
 frost_errcode_t awaiter_cancel(frost_awaiter_t* awaiter);
 
+/**
+ * @brief publish the result of a task bound awaiter after the task returns,
+ * or cancel it if the task has not finished it. nothing is published if the waiter
+ * has timed out. drops the reference of task, the awaiter must not be touched after
+ *
+ * @param awaiter awaiter pointer
+ * @return frost_errcode_t
+ */
+frost_errcode_t awaiter_settle(frost_awaiter_t* awaiter);
+
 #endif /* _FROST_AWAIT_H */
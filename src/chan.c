@@ -10,31 +10,72 @@
 #include "engine.h"
 #include "utils.h"
 #include "chan.h"
+#include "executor.h"
+
+/**
+ * MARK: __chan_pool
+ * @brief get the pack pool of the engine scheduling on current thread
+ *
+ * @return pool_ctx_t* NULL if current thread owns no pool
+ */
+static pool_ctx_t* __chan_pool() {
+
+  // the worker does not own the pool of its engine
+  if(executor_is_worker())
+    return NULL;
+
+  frost_task_ctx_t* _task = NULL;
+  if(!frost_ok(frost_task_get_context(&_task)) || _task == NULL)
+    return NULL;
+
+  return _task->engine->pool.packs;
+}
+
+/**
+ * MARK: __chan_pack_drop
+ * @brief release the data handed over by a write which has failed
+ *
+ * @param stack the message pack of writer
+ */
+static void __chan_pack_drop(chan_pack_t* stack) {
+  if(stack->release && stack->data) stack->release(stack->data);
+}
 
 /**
  * MARK: __chan_pack_retain
  * @brief retain a chanel message pack
- * this function can make a message pack copy to to heap memory
+ * this function can make a message pack copy to to heap memory,
+ * the data handed over with a release callback is referenced instead
  *
+ * @param pool the pack pool of current thread, or NULL
  * @param stack the message pack located on the stack (or anywhere have a chance being overwritten)
  * @param retained the retained copy
  */
-static frost_errcode_t __chan_pack_retain(chan_pack_t* stack, chan_pack_t** retained) {
+static frost_errcode_t __chan_pack_retain(pool_ctx_t* pool, chan_pack_t* stack, chan_pack_t** retained) {
 
-  size_t _length = sizeof(chan_pack_t) + stack->data_len;
-  chan_pack_t* _retained = malloc(_length); {
-    if(!_retained) return frost_err_out_of_memory;
+  bool _owned = stack->release != NULL;
+  size_t _length = sizeof(chan_pack_t) + (_owned ? 0 : stack->data_len);
+  chan_pack_t* _retained = NULL; {
+    if(!frost_ok(pool_alloc(pool, _length, (void **)&_retained)))
+      return frost_err_out_of_memory;
     memset(_retained, 0, _length);
   }
 
-  // make a copy
-  _retained->__ref_count = 0;
-  _retained->data = (uint8_t*)(_retained + 1);
+  // make a copy, held by the writer until it's posted
+  _retained->__ref_count = 1;
   _retained->data_len = stack->data_len;
   _retained->ctrl = stack->ctrl;
   _retained->from = stack->from;
-  if(stack->data_len != 0) {
-    memcpy(_retained->data, stack->data, stack->data_len);
+  _retained->release = stack->release;
+
+  if(_owned) {
+    _retained->data = stack->data;
+  }
+  else {
+    _retained->data = (uint8_t*)(_retained + 1);
+    if(stack->data_len != 0) {
+      memcpy(_retained->data, stack->data, stack->data_len);
+    }
   }
 
   *retained = _retained;
@@ -44,25 +85,263 @@ static frost_errcode_t __chan_pack_retain(chan_pack_t* stack, chan_pack_t** reta
 
 /**
  * MARK: __chan_pack_free
- * @brief free pack
+ * @brief free pack, it goes back to the pool of its writer engine
  * @param retained the retained copy
  */
 static void __chan_pack_free(chan_pack_t* retained) {
-  if(retained) free(retained);
+
+  if(!retained)
+    return;
+
+  __chan_pack_drop(retained);
+  pool_free(__chan_pool(), retained);
 }
 
 /**
-* MARK: frost_chan_alloc_ex
-* @brief allocate channel
-*
-* @param task context
-*/
-frost_errcode_t frost_chan_alloc_ex(frost_task_ctx_t* task) {
+ * MARK: __chan_notify
+ * @brief notify the receiver the new packs have arrived
+ *
+ * @param task the receiver
+ * @param count pack count
+ */
+static void __chan_notify(frost_task_ctx_t* task, int count) {
+
+  frost_chan_t* _chan = task->chan.ref;
+
+  // traced by the engine of writer, the writes out of a task or on a worker are not
+  frost_task_ctx_t* _writer = executor_is_worker() ? NULL : __get_task_ctx(NULL);
+  if(_writer != NULL)
+    frost_trace(_writer->engine, frost_trace_chan_write, task, _chan, (uint32_t)count);
+
+  // the first unread pack wakes up the frozen receiver,
+  // the shared channel leaves it to the engine of receiver
+  if((_chan->notify_cnt += count) == count) {
+    if(_chan->mode == frost_chanmode_local)
+      frost_task_notify(task);
+    else
+      frost_task_notify_remote(task);
+  }
+}
 
-  if(task->chan.ref != NULL) {
-    return frost_err_invalid_parameter;
+/**
+ * MARK: __chan_put
+ * @brief post a retained pack to the receiver
+ *
+ * @param task the receiver
+ * @param pack the retained pack
+ */
+static frost_errcode_t __chan_put(frost_task_ctx_t* task, chan_pack_t* pack) {
+
+  frost_chan_t* _chan = task->chan.ref;
+  frost_errcode_t _result;
+
+  // hold the reference before the receiver can see it
+  ++pack->__ref_count;
+
+  #ifdef FROST_HAS_ATOMICS
+  if(_chan->ring != NULL)
+    _result = aring_push(_chan->ring, pack);
+  else
+  #endif
+    _result = rb_put(_chan->header, (void*)&pack, sizeof(chan_pack_t*));
+
+  if(!frost_ok(_result)) {
+    --pack->__ref_count;
+    return _result;
+  }
+
+  __chan_notify(task, 1);
+  return frost_err_ok;
+}
+
+/**
+ * MARK: __chan_put_many
+ * @brief post the retained packs to the receiver in order, as many as it can hold
+ *
+ * @param task the receiver
+ * @param packs the retained packs
+ * @param count pack count
+ * @param put return the count posted
+ */
+static frost_errcode_t __chan_put_many(frost_task_ctx_t* task, chan_pack_t** packs, size_t count, size_t* put) {
+
+  frost_chan_t* _chan = task->chan.ref;
+  frost_errcode_t _result = frost_err_ok;
+  size_t _put = 0;
+
+  // hold the references before the receiver can see them
+  for(size_t i = 0; i < count; ++i) {
+    ++packs[i]->__ref_count;
+  }
+
+  #ifdef FROST_HAS_ATOMICS
+  if(_chan->ring != NULL) {
+    while(_put < count && frost_ok(_result = aring_push(_chan->ring, packs[_put]))) {
+      ++_put;
+    }
+  }
+  else
+  #endif
+    _result = rb_put_many(_chan->header, (void*)packs, sizeof(chan_pack_t*), count, &_put);
+
+  for(size_t i = _put; i < count; ++i) {
+    --packs[i]->__ref_count;
+  }
+
+  *put = _put;
+  if(_put == 0) {
+    return frost_ok(_result) ? frost_err_full : _result;
+  }
+
+  __chan_notify(task, (int)_put);
+  return frost_err_ok;
+}
+
+/**
+ * MARK: __chan_get
+ * @brief take the next pack from channel
+ *
+ * @param chan the channel
+ * @param pack return the pack
+ */
+static frost_errcode_t __chan_get(frost_chan_t* chan, chan_pack_t** pack) {
+
+  // eof if a writer has claimed the slot but not published yet
+  #ifdef FROST_HAS_ATOMICS
+  if(chan->ring != NULL)
+    return aring_pop(chan->ring, (void **)pack);
+  #endif
+
+  // eof if empty
+  size_t _length = sizeof(chan_pack_t*);
+  return rb_read(chan->header, (void*)pack, &_length, NULL);
+}
+
+/**
+ * MARK: __chan_get_many
+ * @brief take the next packs from channel
+ *
+ * @param chan the channel
+ * @param packs return the packs
+ * @param max max pack count
+ * @param count return the count taken
+ */
+static frost_errcode_t __chan_get_many(frost_chan_t* chan, chan_pack_t** packs, size_t max, size_t* count) {
+
+  #ifdef FROST_HAS_ATOMICS
+  if(chan->ring != NULL)
+    return aring_pop_many(chan->ring, (void **)packs, max, count);
+  #endif
+
+  return rb_read_many(chan->header, (void*)packs, sizeof(chan_pack_t*), max, count);
+}
+
+/**
+ * MARK: __chan_unblock
+ * @brief resume the writers waiting for a free slot
+ *
+ * @param chan the channel
+ */
+static void __chan_unblock(frost_chan_t* chan) {
+
+  ilist_node_t* _node = chan->blocked.head;
+  while(_node) {
+    frost_task_resume(ilist_entry(_node, frost_task_ctx_t, chan.wait_link));
+    _node = _node->next;
+  }
+}
+
+/**
+ * MARK: __chan_wait
+ * @brief wait for the receiver to read. the stackful writer parks until a read of
+ * the local channel resumes it, otherwise checks again after the other tasks run
+ *
+ * @param task the receiver
+ * @param until the tick to give up
+ */
+static void __chan_wait(frost_task_ctx_t* task, uint64_t until) {
+
+  frost_chan_t* _chan = task->chan.ref;
+  frost_task_ctx_t* _self = NULL;
+
+  // drive the engine, the receiver may read in a nested pass
+  if(!frost_task_can_suspend()) {
+    if(executor_is_worker()) idle_yield();
+    else frost_schedule_tasks();
+    return;
   }
 
+  // the receiver on the other engine cannot resume it, check again in next pass
+  frost_task_get_context(&_self);
+  if(_chan->mode != frost_chanmode_local || !frost_ok(ilist_put(&_chan->blocked, &_self->chan.wait_link))) {
+    frost_task_suspend(0);
+    return;
+  }
+
+  _self->chan.wait = _chan;
+  frost_task_suspend(until);
+
+  // resumed by a read or timed out, the destroyed channel has removed it
+  if(_self->chan.wait != NULL) {
+    ilist_delete(&_chan->blocked, &_self->chan.wait_link);
+    _self->chan.wait = NULL;
+  }
+}
+
+/**
+ * MARK: __chan_put_wait
+ * @brief post a retained pack to the receiver, wait while the channel is full
+ *
+ * @param task the receiver
+ * @param pack the retained pack
+ * @param deadline the tick to give up, 0 to wait forever
+ */
+static frost_errcode_t __chan_put_wait(frost_task_ctx_t* task, chan_pack_t* pack, uint64_t deadline) {
+
+  frost_errcode_t _result;
+
+  while((_result = __chan_put(task, pack)) == frost_err_full) {
+
+    uint64_t _now = frost_get_timetick(NULL);
+    if(deadline != 0 && _now >= deadline) {
+      ++task->chan.ref->dropped;
+      return frost_err_task_timeout;
+    }
+
+    // waiting forever still wakes up once in a while to check again
+    __chan_wait(task, deadline != 0 ? deadline : _now + 1000);
+
+    if(!task->chan.ref)
+      return frost_err_invalid_chan;
+  }
+
+  return _result;
+}
+
+/**
+ * MARK: __chan_alloc
+ * @brief allocate channel
+ *
+ * @param task context
+ * @param mode channel mode
+ * @param capacity slots of ring buffer, rounded up to power of two
+ * @param max_capacity the local channel grows by doubling up to it, 0 for the fixed capacity
+ */
+static frost_errcode_t __chan_alloc(frost_task_ctx_t* task, frost_chanmode_t mode,
+  size_t capacity, size_t max_capacity) {
+
+  frost_task_ctx_t* _task = __get_task_ctx(task); {
+    if(_task == NULL || _task->chan.ref != NULL || capacity == 0)
+      return frost_err_invalid_parameter;
+  }
+
+  #ifndef FROST_HAS_ATOMICS
+  if(mode != frost_chanmode_local) {
+    frost_log(TAG, "shared channel requires C11 atomics");
+    return frost_err_fatal_error;
+  }
+  #endif
+
   // prepare chan instance
   frost_chan_t* _chan = (frost_chan_t *)malloc(sizeof(frost_chan_t)); {
     if(!_chan) return frost_err_out_of_memory;
@@ -70,23 +349,69 @@ frost_errcode_t frost_chan_alloc_ex(frost_task_ctx_t* task) {
   }
 
   // create ring buffer
-  rb_header_t* _rb_header = NULL;
-  if(!frost_ok(rb_create(FROST_CHAN_RINGBUFF_SIZE, sizeof(chan_pack_t*), &_rb_header))) {
+  #ifdef FROST_HAS_ATOMICS
+  if(mode != frost_chanmode_local) {
+    aring_mode_t _mode = mode == frost_chanmode_spsc ? aring_spsc : aring_mpsc;
+    if(!frost_ok(aring_create(capacity, _mode, &_chan->ring))) {
+      free(_chan);
+      return frost_err_out_of_memory;
+    }
+  }
+  else
+  #endif
+  if(!frost_ok(rb_create(capacity, max_capacity, sizeof(chan_pack_t*), &_chan->header))) {
     free(_chan);
     return frost_err_out_of_memory;
   }
 
   // initialize chan parameters
-  task->chan.ref = _chan; {
+  _task->chan.ref = _chan; {
     _chan->notify_cnt = 0;
-    _chan->header = _rb_header;
+    _chan->mode = mode;
   }
 
-  frost_log(TAG, "chan rb[%p] has allocated for task '%s'[%p]", _rb_header, task->name, task);
+  frost_log(TAG, "chan[%p] mode %d has allocated for task '%s'[%p]", _chan, mode, _task->name, _task);
 
   return frost_err_ok;
 }
 
+/**
+* MARK: frost_chan_alloc_ex
+* @brief allocate channel
+*
+* @param task context
+*/
+frost_errcode_t frost_chan_alloc_ex(frost_task_ctx_t* task) {
+  return __chan_alloc(task, frost_chanmode_local, FROST_CHAN_RINGBUFF_SIZE, 0);
+}
+
+/**
+* MARK: frost_chan_alloc_sized_ex
+* @brief allocate channel with its own capacity
+*
+* @param task context
+* @param capacity slots, rounded up to power of two
+* @param max_capacity grow by doubling when full up to it, 0 for the fixed capacity
+*/
+frost_errcode_t frost_chan_alloc_sized_ex(frost_task_ctx_t* task, size_t capacity, size_t max_capacity) {
+  return __chan_alloc(task, frost_chanmode_local, capacity, max_capacity);
+}
+
+/**
+* MARK: frost_chan_alloc_shared_ex
+* @brief allocate channel can be written across threads
+*
+* @param task context
+* @param mode spsc or mpsc
+*/
+frost_errcode_t frost_chan_alloc_shared_ex(frost_task_ctx_t* task, frost_chanmode_t mode) {
+
+  if(mode != frost_chanmode_spsc && mode != frost_chanmode_mpsc)
+    return frost_err_invalid_parameter;
+
+  return __chan_alloc(task, mode, FROST_CHAN_RINGBUFF_SIZE, 0);
+}
+
 /**
  * MARK: frost_chan_bind_ex
  * @brief bind channel from A to B (A -> B)
@@ -149,7 +474,7 @@ frost_errcode_t frost_chan_write_ex(frost_task_ctx_t* task_b, chan_pack_t* pack)
   if(pack == NULL) {
     return frost_err_invalid_parameter;
   }
-  
+
   frost_task_ctx_t* _task_a = __get_task_ctx(NULL);
   frost_task_ctx_t* _task_b = task_b; {
     
@@ -160,13 +485,15 @@ frost_errcode_t frost_chan_write_ex(frost_task_ctx_t* task_b, chan_pack_t* pack)
       // the case of invalid task A is the call from outside of the frost context
       if(!_task_a || !_task_a->chan.bind) {
         frost_log(TAG, "task[%p] intented to write a invalid chan", _task_a);
+        __chan_pack_drop(pack);
         return frost_err_invalid_chan;
       }
 
-      // retain the message pack on the heap
+      // retain the message pack on the heap, all receivers share it
       chan_pack_t* _retained_pack = NULL;
-      if(!frost_ok(__chan_pack_retain(pack, &_retained_pack))) {
+      if(!frost_ok(__chan_pack_retain(__chan_pool(), pack, &_retained_pack))) {
         frost_log(TAG, "task[%p] out of memory when retain a chanpack", _task_a);
+        __chan_pack_drop(pack);
         return frost_err_out_of_memory;
       }
 
@@ -179,35 +506,38 @@ frost_errcode_t frost_chan_write_ex(frost_task_ctx_t* task_b, chan_pack_t* pack)
       //    \--> D
 
       // to write messages
-      int32_t _ref_count = 0;
+      int32_t _posted = 0;
       list_node_t* _node = _task_a->chan.bind->head;
       while(_node) {
         frost_task_ctx_t* _to_post = *(frost_task_ctx_t **)_node->data; {
 
-          if(frost_ok(rb_put(_to_post->chan.ref->header, (void*)&_retained_pack, sizeof(chan_pack_t*)))) {
-            ++_to_post->chan.ref->notify_cnt;
-            ++_ref_count;
+          if(frost_ok(__chan_put(_to_post, _retained_pack))) {
+            ++_posted;
             frost_log(TAG, "chanpak[%p]: write flow '%s' -> '%s'", _retained_pack, _task_a->name, _to_post->name);
           }
 
           else {
             frost_log(TAG, "task[%p] rb_put failed... consider out of memory? or full", _to_post);
+            ++_to_post->chan.ref->dropped;
           }
         }
         _node = _node->next;
       }
 
-      // if no task handle this chanpack
-      if (_ref_count == 0) {
+      // drop the writer reference, the receivers on the other threads may have freed theirs
+      if(--_retained_pack->__ref_count <= 0) {
         __chan_pack_free(_retained_pack);
-        return frost_err_full;
       }
 
-      _retained_pack->__ref_count = _ref_count;
+      // if no task handle this chanpack
+      if (_posted == 0) {
+        return frost_err_full;
+      }
     }
 
     // if task B is not contains a chan
     else if(!_task_b->chan.ref) {
+      __chan_pack_drop(pack);
       return frost_err_invalid_chan;
     }
 
@@ -217,7 +547,8 @@ frost_errcode_t frost_chan_write_ex(frost_task_ctx_t* task_b, chan_pack_t* pack)
 
       // retain the message pack on the heap
       chan_pack_t* _retained_pack = NULL;
-      if(!frost_ok(__chan_pack_retain(pack, &_retained_pack))) {
+      if(!frost_ok(__chan_pack_retain(__chan_pool(), pack, &_retained_pack))) {
+        __chan_pack_drop(pack);
         return frost_err_out_of_memory;
       }
 
@@ -225,13 +556,16 @@ frost_errcode_t frost_chan_write_ex(frost_task_ctx_t* task_b, chan_pack_t* pack)
         _retained_pack->from = _task_a;
       }
 
-      if(frost_ok(rb_put(_task_b->chan.ref->header, (void*)&_retained_pack, sizeof(chan_pack_t*)))) {
-        ++_task_b->chan.ref->notify_cnt;
-        ++_retained_pack->__ref_count;
-      }
-      else {
+      frost_errcode_t _result = __chan_put(_task_b, _retained_pack);
+
+      // drop the writer reference
+      if(--_retained_pack->__ref_count <= 0) {
         __chan_pack_free(_retained_pack);
+      }
+
+      if(!frost_ok(_result)) {
         frost_log(TAG, "rb_put failed... consider out of memory? consider chan is full");
+        ++_task_b->chan.ref->dropped;
         return frost_err_full;
       }
     }
@@ -240,6 +574,192 @@ frost_errcode_t frost_chan_write_ex(frost_task_ctx_t* task_b, chan_pack_t* pack)
   return frost_err_ok;
 }
 
+/**
+ * MARK: frost_chan_write_many_ex
+ * @brief write channel packs in batch
+ *
+ * @param task_b task B context, pass NULL to write the bound channels
+ * @param packs the chan_pack_t array on the stack
+ * @param count pack count
+ * @param written return the count written
+ */
+frost_errcode_t frost_chan_write_many_ex(frost_task_ctx_t* task_b, chan_pack_t* packs, size_t count, size_t* written) {
+
+  if(packs == NULL || count == 0) {
+    return frost_err_invalid_parameter;
+  }
+
+  size_t _written = 0;
+  size_t _index = 0;
+  frost_errcode_t _result = frost_err_ok;
+
+  frost_task_ctx_t* _task_a = __get_task_ctx(NULL);
+  if(task_b ? !task_b->chan.ref : (!_task_a || !_task_a->chan.bind)) {
+    frost_log(TAG, "task[%p] intented to write a invalid chan", _task_a);
+    _result = frost_err_invalid_chan;
+  }
+
+  pool_ctx_t* _pool = __chan_pool();
+
+  // retain a batch on the stack at a time, all receivers share it
+  while(frost_ok(_result) && _index < count) {
+
+    chan_pack_t* _retained[FROST_CHAN_BATCH_SIZE];
+    size_t _count = 0;
+
+    for(; _count < FROST_CHAN_BATCH_SIZE && _index < count; ++_count, ++_index) {
+      if(!frost_ok(__chan_pack_retain(_pool, &packs[_index], &_retained[_count]))) {
+        frost_log(TAG, "task[%p] out of memory when retain a chanpack", _task_a);
+        _result = frost_err_out_of_memory;
+        break;
+      }
+
+      if(!_retained[_count]->from) {
+        _retained[_count]->from = _task_a;
+      }
+    }
+
+    // the receiver holds a prefix of the batch, the rest is dropped.
+    // a broadcast counts the packs held by any receiver
+    size_t _posted = 0;
+    size_t _put = 0;
+
+    // A --> B
+    if(task_b) {
+      if(_count != 0) __chan_put_many(task_b, _retained, _count, &_posted);
+      task_b->chan.ref->dropped += _count - _posted;
+    }
+
+    // A --> B, C, D
+    else {
+      list_node_t* _node = _task_a->chan.bind->head;
+      while(_node) {
+        frost_task_ctx_t* _to_post = *(frost_task_ctx_t **)_node->data;
+
+        _put = 0;
+        if(_count != 0) __chan_put_many(_to_post, _retained, _count, &_put);
+        _to_post->chan.ref->dropped += _count - _put;
+
+        if(_put > _posted) _posted = _put;
+        _node = _node->next;
+      }
+    }
+
+    // drop the writer references
+    for(size_t i = 0; i < _count; ++i) {
+      if(--_retained[i]->__ref_count <= 0) {
+        __chan_pack_free(_retained[i]);
+      }
+    }
+
+    _written += _posted;
+  }
+
+  if(frost_ok(_result) && _written < count) {
+    _result = frost_err_full;
+  }
+
+  // the data handed over is taken even if not written
+  for(; _index < count; ++_index) {
+    __chan_pack_drop(&packs[_index]);
+  }
+
+  if(written) {
+    *written = _written;
+  }
+
+  return _result;
+}
+
+/**
+ * MARK: frost_chan_write_wait_ex
+ * @brief write channel pack, wait for the free slots instead of dropping it
+ *
+ * @param task_b task B context, pass NULL to write the bound channels
+ * @param pack the chan_pack_t pointer on the stack
+ * @param timeout timeout in milliseconds, 0 to wait forever
+ */
+frost_errcode_t frost_chan_write_wait_ex(frost_task_ctx_t* task_b, chan_pack_t* pack, uint32_t timeout) {
+
+  if(pack == NULL) {
+    return frost_err_invalid_parameter;
+  }
+
+  frost_task_ctx_t* _task_a = __get_task_ctx(NULL);
+
+  if(task_b ? !task_b->chan.ref : (!_task_a || !_task_a->chan.bind)) {
+    frost_log(TAG, "task[%p] intented to write a invalid chan", _task_a);
+    __chan_pack_drop(pack);
+    return frost_err_invalid_chan;
+  }
+
+  // retain the message pack on the heap, all receivers share it
+  chan_pack_t* _retained_pack = NULL;
+  if(!frost_ok(__chan_pack_retain(__chan_pool(), pack, &_retained_pack))) {
+    __chan_pack_drop(pack);
+    return frost_err_out_of_memory;
+  }
+
+  if(!_retained_pack->from) {
+    _retained_pack->from = _task_a;
+  }
+
+  uint64_t _deadline = timeout != 0 ? frost_get_timetick(NULL) + timeout : 0;
+  frost_errcode_t _result = frost_err_ok;
+
+  // A --> B
+  if(task_b) {
+    _result = __chan_put_wait(task_b, _retained_pack, _deadline);
+  }
+
+  // A --> B, C, D one by one. the bound list may change while waiting,
+  // walk it by index again. after the timeout the rest are written without waiting
+  else {
+    for(size_t i = 0; ; ++i) {
+
+      list_node_t* _node = _task_a->chan.bind ? _task_a->chan.bind->head : NULL;
+      for(size_t j = 0; _node && j < i; ++j) _node = _node->next;
+      if(!_node) break;
+
+      frost_task_ctx_t* _to_post = *(frost_task_ctx_t **)_node->data;
+      frost_errcode_t _ret = __chan_put_wait(_to_post, _retained_pack, _deadline);
+      if(!frost_ok(_ret)) {
+        _result = _ret;
+        if(_deadline == 0) _deadline = 1;
+      }
+    }
+  }
+
+  // drop the writer reference
+  if(--_retained_pack->__ref_count <= 0) {
+    __chan_pack_free(_retained_pack);
+  }
+
+  return _result;
+}
+
+/**
+ * MARK: frost_chan_get_dropped_ex
+ * @brief get the count of packs not written since the channel was full
+ *
+ * @param task task context
+ * @param dropped return the count
+ */
+frost_errcode_t frost_chan_get_dropped_ex(frost_task_ctx_t* task, size_t* dropped) {
+
+  frost_task_ctx_t* _task = __get_task_ctx(task);
+  if(!_task || !_task->chan.ref) {
+    return frost_err_invalid_chan;
+  }
+
+  if(dropped == NULL) {
+    return frost_err_invalid_parameter;
+  }
+
+  *dropped = _task->chan.ref->dropped;
+  return frost_err_ok;
+}
+
 /**
  * MARK: frost_chan_read
  * @brief read channel pack
@@ -259,24 +779,22 @@ frost_errcode_t frost_chan_read(chan_pack_t** pack) {
     return frost_err_eof;
   }
 
-  size_t _length = 0;
-  size_t _remain = 0;
   chan_pack_t* _pack = NULL;
+  frost_errcode_t _result;
 
-  // get ring buffer info
-  if(!frost_ok(rb_read(_task_a->chan.ref->header, NULL, &_length, &_remain))) {
-    // todo print something
+  // an mpsc channel may count a pack behind the slot not published yet
+  if(!frost_ok(_result = __chan_get(_task_a->chan.ref, &_pack))) {
     if(pack != NULL) *pack = NULL;
-    return frost_err_ok;
-  }
-
-  // get ring buffer data
-  if(!frost_ok(rb_read(_task_a->chan.ref->header, (void*)&_pack, &_length, &_remain))) {
-    if(pack != NULL) *pack = NULL;
-    return frost_err_fatal_error;
+    return _result;
   }
 
   --_task_a->chan.ref->notify_cnt;
+  frost_trace(_task_a->engine, frost_trace_chan_read, _task_a, _task_a->chan.ref, 1);
+
+  // a slot is free, the waiting writers try again
+  if(_task_a->chan.ref->blocked.head != NULL) {
+    __chan_unblock(_task_a->chan.ref);
+  }
 
   // if the ref count is alrady 0, wtf?
   if(_pack->__ref_count <= 0) {
@@ -299,6 +817,99 @@ frost_errcode_t frost_chan_read(chan_pack_t** pack) {
   }
 }
 
+/**
+ * MARK: frost_chan_read_many
+ * @brief read channel packs in batch
+ *
+ * @param packs the chan_pack_t* array
+ * @param max max pack count
+ * @param count return the count read
+ */
+frost_errcode_t frost_chan_read_many(chan_pack_t** packs, size_t max, size_t* count) {
+
+  if(packs == NULL || count == NULL || max == 0) {
+    return frost_err_invalid_parameter;
+  }
+
+  *count = 0;
+
+  frost_task_ctx_t* _task_a = __get_task_ctx(NULL);
+  if(!_task_a || !_task_a->chan.ref) {
+    return frost_err_invalid_chan;
+  }
+
+  frost_chan_t* _chan = _task_a->chan.ref;
+
+  // no message came in
+  int _notify = _chan->notify_cnt;
+  if(_notify <= 0) {
+    return frost_err_eof;
+  }
+
+  if((size_t)_notify < max) max = (size_t)_notify;
+
+  size_t _count = 0;
+  frost_errcode_t _result;
+
+  // an mpsc channel may count a pack behind the slot not published yet
+  if(!frost_ok(_result = __chan_get_many(_chan, packs, max, &_count))) {
+    return _result;
+  }
+
+  _chan->notify_cnt -= (int)_count;
+  frost_trace(_task_a->engine, frost_trace_chan_read, _task_a, _chan, (uint32_t)_count);
+
+  // the slots are free, the waiting writers try again
+  if(_chan->blocked.head != NULL) {
+    __chan_unblock(_chan);
+  }
+
+  // keep the data packs in order, the control packs are consumed here
+  size_t _read = 0;
+  bool _closed = false;
+  for(size_t i = 0; i < _count; ++i) {
+    if(packs[i]->ctrl == frost_chanctl_ok) {
+      packs[_read++] = packs[i];
+    }
+    else {
+      frost_log(TAG, "chanpak[%p]: [control] channel closed", packs[i]);
+      frost_chan_free_pack(packs[i]);
+      _closed = true;
+    }
+  }
+
+  frost_log(TAG, "task[%p] '%s' read %zu packs from channel", _task_a, _task_a->name, _read);
+
+  *count = _read;
+  return _closed ? frost_err_closed : frost_err_ok;
+}
+
+/**
+ * MARK: frost_chan_free_packs
+ * @brief free the chan packs after read in batch
+ *
+ * @param packs the chan_pack_t* array
+ * @param count pack count
+ */
+frost_errcode_t frost_chan_free_packs(chan_pack_t** packs, size_t count) {
+
+  if(!packs) {
+    return frost_err_invalid_parameter;
+  }
+
+  // the pool is looked up once for the batch
+  pool_ctx_t* _pool = __chan_pool();
+
+  for(size_t i = 0; i < count; ++i) {
+    if(packs[i] && --packs[i]->__ref_count <= 0) {
+      __chan_pack_drop(packs[i]);
+      pool_free(_pool, packs[i]);
+    }
+  }
+
+  return frost_err_ok;
+}
+
 /**
  * MARK: frost_chan_free_pack
  * @brief free a chan pack after read
@@ -403,9 +1014,10 @@ frost_errcode_t frost_chan_destroy_ex(frost_task_ctx_t* task_a) {
     return frost_err_invalid_parameter;
   }
 
-  // unbind from all tasks
+  // unbind from all tasks. the writers on the other engines
+  // must be unbound by their owners before this
   frost_task_enum_t _enum = {0};
-  while(frost_enumerate_tasks(&_enum) == frost_err_ok) {
+  while(frost_enumerate_tasks_ex(_task_a->engine, &_enum) == frost_err_ok) {
     if(_enum.task != _task_a && frost_chan_is_allocated_ex(_enum.task)) {
       frost_chan_unbind_ex(_enum.task, _task_a);
       frost_log(TAG, "task[%p]: unbinded to task[%p]", _enum.task, _task_a);
@@ -418,14 +1030,30 @@ frost_errcode_t frost_chan_destroy_ex(frost_task_ctx_t* task_a) {
     frost_log(TAG, "task[%p]: has unread channel packs, do clean", _task_a);
 
     chan_pack_t* _pack = NULL;
-    while(frost_chan_read(&_pack) != frost_err_eof) {
+    while(frost_ok(__chan_get(_task_a->chan.ref, &_pack))) {
       frost_chan_free_pack(_pack);
     }
   }
 
+  // the waiting writers give up
+  ilist_node_t* _waiter = NULL;
+  while((_waiter = _task_a->chan.ref->blocked.head) != NULL) {
+    frost_task_ctx_t* _writer = ilist_entry(_waiter, frost_task_ctx_t, chan.wait_link);
+    ilist_delete(&_task_a->chan.ref->blocked, _waiter);
+    _writer->chan.wait = NULL;
+    frost_task_resume(_writer);
+  }
+
   // do destroy & cleanup
   list_destroy(_task_a->chan.bind);
-  rb_destroy(_task_a->chan.ref->header);
+
+  #ifdef FROST_HAS_ATOMICS
+  if(_task_a->chan.ref->ring != NULL)
+    aring_destroy(_task_a->chan.ref->ring);
+  else
+  #endif
+    rb_destroy(_task_a->chan.ref->header);
+
   free(_task_a->chan.ref); {
     _task_a->chan.ref = NULL;
     _task_a->chan.bind = NULL;
@@ -434,6 +1062,37 @@ frost_errcode_t frost_chan_destroy_ex(frost_task_ctx_t* task_a) {
   return frost_err_ok;
 }
 
+/**
+ * MARK: frost_chan_get_pool_stats_ex
+ * @brief get the statistics of channel pack pool
+ *
+ * @param e engine
+ * @param stats return the statistics
+ */
+frost_errcode_t frost_chan_get_pool_stats_ex(frost_engine_t* e, pool_stats_t* stats) {
+
+  if(e == NULL || stats == NULL)
+    return frost_err_invalid_parameter;
+  else if(!e->initialized)
+    return frost_err_need_initialize;
+
+  return pool_get_stats(e->pool.packs, stats);
+}
+
+/**
+ * MARK: frost_chan_get_pool_stats
+ * @brief get the statistics of channel pack pool
+ *
+ * @param stats return the statistics
+ */
+frost_errcode_t frost_chan_get_pool_stats(pool_stats_t* stats) {
+
+  frost_engine_t* _engine = NULL;
+  frost_get_engine(&_engine);
+
+  return frost_chan_get_pool_stats_ex(_engine, stats);
+}
+
 /**
  * MARK: frost_chan_alloc
  * @brief allocate channel
@@ -442,6 +1101,27 @@ frost_errcode_t frost_chan_alloc() {
   return frost_chan_alloc_ex(NULL);
 }
 
+/**
+ * MARK: frost_chan_alloc_sized
+ * @brief allocate channel with its own capacity
+ *
+ * @param capacity slots, rounded up to power of two
+ * @param max_capacity grow by doubling when full up to it, 0 for the fixed capacity
+ */
+frost_errcode_t frost_chan_alloc_sized(size_t capacity, size_t max_capacity) {
+  return frost_chan_alloc_sized_ex(NULL, capacity, max_capacity);
+}
+
+/**
+ * MARK: frost_chan_alloc_shared
+ * @brief allocate channel can be written across threads
+ *
+ * @param mode spsc or mpsc
+ */
+frost_errcode_t frost_chan_alloc_shared(frost_chanmode_t mode) {
+  return frost_chan_alloc_shared_ex(NULL, mode);
+}
+
 /**
  * MARK: frost_chan_destroy
  * @brief destroy channel
@@ -481,6 +1161,39 @@ bool frost_chan_is_allocated() {
   return frost_chan_is_allocated_ex(NULL);
 }
 
+/**
+ * MARK: frost_chan_write_many
+ * @brief write the bound channels in batch
+ *
+ * @param packs the chan_pack_t array on the stack
+ * @param count pack count
+ * @param written return the count written
+ */
+frost_errcode_t frost_chan_write_many(chan_pack_t* packs, size_t count, size_t* written) {
+  return frost_chan_write_many_ex(NULL, packs, count, written);
+}
+
+/**
+ * MARK: frost_chan_write_wait
+ * @brief write the bound channels, wait for the free slots instead of dropping it
+ *
+ * @param pack the chan_pack_t pointer on the stack
+ * @param timeout timeout in milliseconds, 0 to wait forever
+ */
+frost_errcode_t frost_chan_write_wait(chan_pack_t* pack, uint32_t timeout) {
+  return frost_chan_write_wait_ex(NULL, pack, timeout);
+}
+
+/**
+ * MARK: frost_chan_get_dropped
+ * @brief get the count of packs not written since the channel was full
+ *
+ * @param dropped return the count
+ */
+frost_errcode_t frost_chan_get_dropped(size_t* dropped) {
+  return frost_chan_get_dropped_ex(NULL, dropped);
+}
+
 /**
  * MARK: frost_chan_unbind
  * @brief unbind channel
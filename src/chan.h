@@ -20,6 +20,29 @@
 frost_errcode_t frost_chan_alloc_ex(frost_task_ctx_t* task);
 frost_errcode_t frost_chan_alloc();
 
+/**
+ * @brief allocate channel with its own capacity instead of FROST_CHAN_RINGBUFF_SIZE.
+ * the hot channel may start small and grow by doubling when it's full
+ *
+ * @param task context
+ * @param capacity slots, rounded up to power of two
+ * @param max_capacity grow up to it, 0 for the fixed capacity
+ */
+frost_errcode_t frost_chan_alloc_sized_ex(frost_task_ctx_t* task, size_t capacity, size_t max_capacity);
+frost_errcode_t frost_chan_alloc_sized(size_t capacity, size_t max_capacity);
+
+/**
+ * @brief allocate channel can be written from the other threads and engines.
+ * the packs are passed by a lock-free ring buffer, and the frozen receiver
+ * is woken up by its own engine
+ *
+ * @param task context
+ * @param mode frost_chanmode_spsc for one writer thread at a time,
+ * frost_chanmode_mpsc for any writers
+ */
+frost_errcode_t frost_chan_alloc_shared_ex(frost_task_ctx_t* task, frost_chanmode_t mode);
+frost_errcode_t frost_chan_alloc_shared(frost_chanmode_t mode);
+
 frost_errcode_t frost_chan_destroy();
 
 /**
@@ -50,16 +73,27 @@ frost_errcode_t frost_chan_crossbind(frost_task_ctx_t* task_b);
 bool frost_chan_is_allocated_ex(frost_task_ctx_t* task);
 bool frost_chan_is_allocated();
 
+/**
+ * @brief free the data handed over to a channel
+ *
+ * @param data the data of pack
+ */
+typedef void (* frost_chan_release_t)(void* data);
+
 typedef struct _chan_pack_t {
-  int32_t __ref_count;
+  FROST_ATOMIC(int32_t) __ref_count; /* the receivers may free it on the other threads */
   frost_task_ctx_t* from;
   frost_chanctl_t ctrl;
   void* data;
   uint32_t data_len;
+  frost_chan_release_t release; /* hand over data without a copy, called after the last read */
 } chan_pack_t;
 
 /**
- * @brief write channel pack
+ * @brief write channel pack. the data is copied, unless pack->release is set.
+ * with a release callback the channel takes over the data without a copy,
+ * all receivers of a broadcast share it, and it's released after the last read.
+ * the data is taken over even if the write fails, don't touch it after
  *
  * @param task_b task B context, pass NULL to write the bound channels
  * @param pack the chan_pack_t pointer on the stack
@@ -81,6 +115,60 @@ frost_errcode_t frost_chan_write_ex(frost_task_ctx_t* task_b, chan_pack_t* pack)
     ), \
   })
 
+/**
+ * @brief write channel packs in batch, in order. every receiver is put the batch
+ * at once, with one capacity check and one wakeup. a receiver holds as many as
+ * it can, the rest are dropped. like @ref frost_chan_write_ex() the data handed
+ * over is taken even if it's not written
+ *
+ * @param task_b task B context, pass NULL to write the bound channels
+ * @param packs the chan_pack_t array on the stack
+ * @param count pack count
+ * @param written return the count written, a broadcast counts the packs held by any receiver
+ * @return frost_errcode_t frost_err_full if not all packs are written
+ */
+frost_errcode_t frost_chan_write_many_ex(frost_task_ctx_t* task_b, chan_pack_t* packs, size_t count, size_t* written);
+frost_errcode_t frost_chan_write_many(chan_pack_t* packs, size_t count, size_t* written);
+
+/**
+ * @brief write channel pack, wait for the free slots instead of dropping it when
+ * the channel is full. the stackful writer parks until the receiver reads,
+ * otherwise the engine runs the other tasks meanwhile. the bound channels are
+ * written one by one, and a timeout skips the rest still full
+ *
+ * @param task_b task B context, pass NULL to write the bound channels
+ * @param pack the chan_pack_t pointer on the stack
+ * @param timeout timeout in milliseconds, 0 to wait forever
+ * @return frost_errcode_t frost_err_task_timeout if a channel is still full after timeout
+ */
+frost_errcode_t frost_chan_write_wait_ex(frost_task_ctx_t* task_b, chan_pack_t* pack, uint32_t timeout);
+frost_errcode_t frost_chan_write_wait(chan_pack_t* pack, uint32_t timeout);
+
+/**
+ * @brief get the count of packs not written since the channel was full,
+ * include the timed out waiting writes
+ *
+ * @param task task context
+ * @param dropped return the count
+ */
+frost_errcode_t frost_chan_get_dropped_ex(frost_task_ctx_t* task, size_t* dropped);
+frost_errcode_t frost_chan_get_dropped(size_t* dropped);
+
+/**
+ * @brief write channel, hand over the data without a copy
+ *
+ * @param ptr data pointer, owned by the channel after
+ * @param len data length
+ * @param release_fn frost_chan_release_t to free the data after the last read, e.g. free
+ */
+#define frost_chan_write_owned(ptr, len, release_fn) \
+  frost_chan_write_ex(NULL, &(chan_pack_t) { \
+    .ctrl = frost_chanctl_ok, \
+    .data = (void *)(ptr), \
+    .data_len = (len), \
+    .release = (release_fn), \
+  })
+
 /**
  * @brief read channel pack. read a pack from channel.
  *
@@ -89,6 +177,18 @@ frost_errcode_t frost_chan_write_ex(frost_task_ctx_t* task_b, chan_pack_t* pack)
  */
 frost_errcode_t frost_chan_read(chan_pack_t** pack);
 
+/**
+ * @brief read channel packs in batch, up to max packs in order. the control packs
+ * are consumed and not returned, free the returned packs by @ref frost_chan_free_packs()
+ *
+ * @param packs the chan_pack_t* array holds max packs
+ * @param max max pack count
+ * @param count return the count read
+ * @return frost_errcode_t frost_err_eof if nothing came in, frost_err_closed if a close
+ * pack was consumed, the data packs are still returned
+ */
+frost_errcode_t frost_chan_read_many(chan_pack_t** packs, size_t max, size_t* count);
+
 /**
  * @brief unbind all channels, clear internal ringbuffer, and destroy the channel.
  * after invoke this function the unread channel messages will free and destroy automatically,
@@ -99,12 +199,21 @@ frost_errcode_t frost_chan_read(chan_pack_t** pack);
 frost_errcode_t frost_chan_destroy_ex(frost_task_ctx_t* task_a);
 
 /**
- * @brief free a chan pack after read
+ * @brief free a chan pack after read, the data handed over is released
+ * after all receivers free it
  *
  * @param pack channel pack
  */
 frost_errcode_t frost_chan_free_pack(chan_pack_t* pack);
 
+/**
+ * @brief free the chan packs after read in batch
+ *
+ * @param packs the chan_pack_t* array
+ * @param count pack count
+ */
+frost_errcode_t frost_chan_free_packs(chan_pack_t** packs, size_t count);
+
 /**
  * @brief unbind tasks. this function do unbind channels between task_a and task_b,
  * this affects both sides (A <-> B).
@@ -116,4 +225,15 @@ frost_errcode_t frost_chan_free_pack(chan_pack_t* pack);
 frost_errcode_t frost_chan_unbind_ex(frost_task_ctx_t* task_a, frost_task_ctx_t* task_b);
 frost_errcode_t frost_chan_unbind(frost_task_ctx_t* task_b);
 
+/**
+ * @brief get the statistics of channel pack pool. the packs written by the tasks
+ * of an engine are taken from its pool by size class, and given back after the last read.
+ * call on the thread scheduling the engine
+ *
+ * @param e engine
+ * @param stats return the hit/miss counters and cached packs
+ */
+frost_errcode_t frost_chan_get_pool_stats_ex(frost_engine_t* e, pool_stats_t* stats);
+frost_errcode_t frost_chan_get_pool_stats(pool_stats_t* stats);
+
 #endif /* _FROST_CHAN_H */
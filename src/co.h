@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#ifndef _FROST_CO_H
+#define _FROST_CO_H
+
+#include <string.h>
+
+#include "engine.h"
+
+/*
+ * stackless tasks (protothread style). the callback returns at every wait point
+ * with its resume point saved in the task, the scheduler calls it again when
+ * the wait is over and it jumps back to where it left. the locals live in
+ * the frame of the task, not on the stack, e.g.
+ *
+ *   void blink() {
+ *     FROST_CO_BEGIN(struct { int state; });
+ *     for(;;) {
+ *       digitalWrite(LED_BUILTIN, co->state = !co->state);
+ *       FROST_CO_SLEEP(1000);
+ *     }
+ *     FROST_CO_END();
+ *   }
+ *
+ * - the stack locals are lost at every wait point, keep them in co
+ * - only one wait point per source line, and not inside a switch statement
+ * - leave with FROST_CO_END() or FROST_CO_EXIT(), never a plain return
+ */
+
+/**
+ * @brief begin a stackless task, declare co as the pointer to its locals.
+ * called outside of a task it returns at once
+ *
+ * @param T type of the locals, at most FROST_CO_FRAME_SIZE bytes
+ */
+#define FROST_CO_BEGIN(T) \
+  frost_task_ctx_t* __co_task = NULL; \
+  if(!frost_ok(frost_task_get_context(&__co_task)) || __co_task == NULL) return; \
+  typedef char __co_frame_check[(sizeof(T) <= FROST_CO_FRAME_SIZE) ? 1 : -1]; \
+  T* co = (void *)__co_task->coro.frame.bytes; \
+  (void)sizeof(__co_frame_check); (void)co; \
+  switch(__co_task->coro.line) { case 0:
+
+/**
+ * @brief return to the scheduler and save the resume point
+ */
+#define __FROST_CO_SUSPEND(tick) \
+  __co_task->coro.until = (tick); \
+  __co_task->coro.line = __LINE__; \
+  return; \
+  case __LINE__:
+
+/**
+ * @brief resume in next pass
+ */
+#define FROST_CO_YIELD() \
+  do { __FROST_CO_SUSPEND(0); } while(0)
+
+/**
+ * @brief resume after the duration (ms)
+ *
+ * @param duration_ms duration in millisecond
+ */
+#define FROST_CO_SLEEP(duration_ms) \
+  do { \
+    __FROST_CO_SUSPEND(frost_get_timetick(NULL) + (duration_ms)); \
+    if(frost_get_timetick(NULL) < __co_task->coro.until) return; \
+  } while(0)
+
+/**
+ * @brief resume after the awaiter finished, it's checked every pass.
+ * the expression is evaluated at every check, pass a stored awaiter like co->awaiter
+ *
+ * @param awaiter the awaiter
+ */
+#define FROST_CO_AWAIT(awaiter) \
+  do { \
+    __co_task->coro.line = __LINE__; \
+    if(0) { case __LINE__:; } \
+    if(!(awaiter)->is_finished) { \
+      __co_task->coro.until = 0; \
+      return; \
+    } \
+  } while(0)
+
+/**
+ * @brief leave the task, the next run starts over with cleared locals
+ */
+#define FROST_CO_EXIT() \
+  do { \
+    __co_task->coro.line = 0; \
+    memset(&__co_task->coro.frame, 0, sizeof(__co_task->coro.frame)); \
+    return; \
+  } while(0)
+
+/**
+ * @brief end a stackless task
+ */
+#define FROST_CO_END() \
+  } FROST_CO_EXIT()
+
+#endif /* _FROST_CO_H */
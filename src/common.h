@@ -32,8 +32,48 @@ typedef enum {
   frost_err_eof                    = -8,
   frost_err_closed                 = -9,
   frost_err_full                   = -10,
+  frost_err_overload               = -11,
 } frost_errcode_t;
 
 #define frost_ok(x) ((x) == frost_err_ok)
 
+/**
+ * @brief C11 atomics are available
+ */
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && \
+    !defined(__STDC_NO_ATOMICS__) && !defined(FROST_NO_ATOMICS)
+  #define FROST_HAS_ATOMICS
+#endif
+
+/**
+ * @brief atomic type specifier for the data shared between threads
+ */
+#ifdef FROST_HAS_ATOMICS
+  #define FROST_ATOMIC(type) _Atomic(type)
+#else
+  #define FROST_ATOMIC(type) volatile type
+#endif
+
+/**
+ * @brief cache line size, the data shared between threads are padded to it
+ */
+#ifndef FROST_CACHE_LINE
+  #define FROST_CACHE_LINE 64
+#endif
+
+/**
+ * @brief thread local storage specifier
+ */
+#ifndef FROST_THREAD_LOCAL
+  #if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L && !defined(__STDC_NO_THREADS__)
+    #define FROST_THREAD_LOCAL _Thread_local
+  #elif defined(__GNUC__)
+    #define FROST_THREAD_LOCAL __thread
+  #elif defined(_MSC_VER)
+    #define FROST_THREAD_LOCAL __declspec(thread)
+  #else
+    #define FROST_THREAD_LOCAL
+  #endif
+#endif
+
 #endif /* _FROST_COMMON_H */
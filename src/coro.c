@@ -0,0 +1,517 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#include "coro.h"
+
+#if defined(FROST_CORO_UCONTEXT) && defined(__APPLE__) && !defined(_XOPEN_SOURCE)
+  #define _XOPEN_SOURCE 600
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "common.h"
+#include "log.h"
+
+#ifdef FROST_HAS_CORO
+
+#ifdef FROST_CORO_UCONTEXT
+  #include <ucontext.h>
+#endif
+
+#ifdef FROST_CORO_GUARD
+  #include <sys/mman.h>
+  #include <unistd.h>
+
+  #if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+    #define MAP_ANONYMOUS MAP_ANON
+  #endif
+#endif
+
+/**
+ * @brief written at the bottom of every stack, an overflow overwrites it first
+ */
+#define __CORO_CANARY ((uint64_t)0xF705C0DEF705C0DEULL)
+
+struct _coro_t {
+  struct _coro_t* next; /* next free stack of the pool */
+  struct _coro_t* caller; /* the coroutine resumed this one, NULL for thread stack */
+  void* sp; /* stack pointer saved by the coroutine */
+  void* caller_sp; /* stack pointer saved by the resumer */
+  coro_entry_t entry;
+  void* arg;
+  uint8_t* stack;
+  size_t size;
+  void* block; /* the allocation holds the stack and this header above it */
+  size_t block_size;
+  bool running;
+  bool finished;
+  #ifdef FROST_CORO_UCONTEXT
+  ucontext_t ctx;
+  ucontext_t caller_ctx;
+  #endif
+};
+
+struct _coro_pool_t {
+  coro_t* free; /* the stacks ready for reuse */
+  size_t count;
+  size_t max_pooled;
+  size_t stack_size;
+};
+
+static FROST_THREAD_LOCAL coro_t* __coro_current = NULL;
+
+#ifdef FROST_CORO_ASM
+
+#ifdef __APPLE__
+  #define __CORO_SYM(name) "_" #name
+  #define __CORO_HIDE(name) ".private_extern " __CORO_SYM(name) "\n"
+#elif defined(__ELF__)
+  #define __CORO_SYM(name) #name
+  #define __CORO_HIDE(name) ".hidden " __CORO_SYM(name) "\n"
+#else
+  #define __CORO_SYM(name) #name
+  #define __CORO_HIDE(name)
+#endif
+
+#define __CORO_FUNC(name) \
+  ".globl " __CORO_SYM(name) "\n" \
+  __CORO_HIDE(name) \
+  ".p2align 4\n" \
+  __CORO_SYM(name) ":\n"
+
+/**
+ * @brief save the callee-saved registers on current stack, store the stack pointer
+ * to *from, then restore the registers from the stack of to and return there
+ */
+void __frost_coro_switch(void** from, void* to);
+
+/**
+ * @brief the first return address of a new coroutine, call the main function
+ * saved in the callee-saved registers
+ */
+void __frost_coro_boot();
+
+#if defined(__x86_64__)
+
+/* frame: mxcsr/x87 cw, r15, r14, r13, r12, rbx, rbp, return address */
+#define __CORO_FRAME_SIZE 80
+
+__asm__(
+  ".text\n"
+  __CORO_FUNC(__frost_coro_switch)
+  "  pushq %rbp\n"
+  "  pushq %rbx\n"
+  "  pushq %r12\n"
+  "  pushq %r13\n"
+  "  pushq %r14\n"
+  "  pushq %r15\n"
+  "  subq $8, %rsp\n"
+  "  stmxcsr (%rsp)\n"
+  "  fnstcw 4(%rsp)\n"
+  "  movq %rsp, (%rdi)\n"
+  "  movq %rsi, %rsp\n"
+  "  ldmxcsr (%rsp)\n"
+  "  fldcw 4(%rsp)\n"
+  "  addq $8, %rsp\n"
+  "  popq %r15\n"
+  "  popq %r14\n"
+  "  popq %r13\n"
+  "  popq %r12\n"
+  "  popq %rbx\n"
+  "  popq %rbp\n"
+  "  ret\n"
+  __CORO_FUNC(__frost_coro_boot)
+  "  movq %r12, %rdi\n"
+  "  callq *%r13\n"
+  "  ud2\n"
+);
+
+/**
+ * MARK: __coro_frame
+ * @brief build the first frame, the switch pops it and returns to the boot
+ */
+static void* __coro_frame(uint8_t* top, void (* main)(coro_t*), coro_t* coro) {
+
+  uint64_t* _frame = (uint64_t *)(top - __CORO_FRAME_SIZE);
+  memset(_frame, 0, __CORO_FRAME_SIZE);
+
+  _frame[0] = 0x1F80 | ((uint64_t)0x037F << 32); /* default mxcsr and x87 control word */
+  _frame[3] = (uint64_t)(uintptr_t)main; /* r13 */
+  _frame[4] = (uint64_t)(uintptr_t)coro; /* r12 */
+  _frame[7] = (uint64_t)(uintptr_t)__frost_coro_boot;
+
+  return _frame;
+}
+
+#elif defined(__aarch64__)
+
+/* frame: x19 - x28, x29, x30, d8 - d15 */
+#define __CORO_FRAME_SIZE 160
+
+__asm__(
+  ".text\n"
+  __CORO_FUNC(__frost_coro_switch)
+  "  sub sp, sp, #160\n"
+  "  stp x19, x20, [sp, #0]\n"
+  "  stp x21, x22, [sp, #16]\n"
+  "  stp x23, x24, [sp, #32]\n"
+  "  stp x25, x26, [sp, #48]\n"
+  "  stp x27, x28, [sp, #64]\n"
+  "  stp x29, x30, [sp, #80]\n"
+  "  stp d8, d9, [sp, #96]\n"
+  "  stp d10, d11, [sp, #112]\n"
+  "  stp d12, d13, [sp, #128]\n"
+  "  stp d14, d15, [sp, #144]\n"
+  "  mov x9, sp\n"
+  "  str x9, [x0]\n"
+  "  mov sp, x1\n"
+  "  ldp x19, x20, [sp, #0]\n"
+  "  ldp x21, x22, [sp, #16]\n"
+  "  ldp x23, x24, [sp, #32]\n"
+  "  ldp x25, x26, [sp, #48]\n"
+  "  ldp x27, x28, [sp, #64]\n"
+  "  ldp x29, x30, [sp, #80]\n"
+  "  ldp d8, d9, [sp, #96]\n"
+  "  ldp d10, d11, [sp, #112]\n"
+  "  ldp d12, d13, [sp, #128]\n"
+  "  ldp d14, d15, [sp, #144]\n"
+  "  add sp, sp, #160\n"
+  "  ret\n"
+  __CORO_FUNC(__frost_coro_boot)
+  "  mov x0, x19\n"
+  "  blr x20\n"
+  "  brk #0\n"
+);
+
+/**
+ * MARK: __coro_frame
+ * @brief build the first frame, the switch pops it and returns to the boot
+ */
+static void* __coro_frame(uint8_t* top, void (* main)(coro_t*), coro_t* coro) {
+
+  uint64_t* _frame = (uint64_t *)(top - __CORO_FRAME_SIZE);
+  memset(_frame, 0, __CORO_FRAME_SIZE);
+
+  _frame[0] = (uint64_t)(uintptr_t)coro; /* x19 */
+  _frame[1] = (uint64_t)(uintptr_t)main; /* x20 */
+  _frame[11] = (uint64_t)(uintptr_t)__frost_coro_boot; /* x30 */
+
+  return _frame;
+}
+
+#endif
+
+#endif /* FROST_CORO_ASM */
+
+/**
+ * MARK: __coro_leave
+ * @brief switch from the coroutine back to its resumer
+ */
+static void __coro_leave(coro_t* coro) {
+  #ifdef FROST_CORO_ASM
+  __frost_coro_switch(&coro->sp, coro->caller_sp);
+  #else
+  swapcontext(&coro->ctx, &coro->caller_ctx);
+  #endif
+}
+
+/**
+ * MARK: __coro_main
+ * @brief run the entry on the coroutine stack, never returns
+ */
+static void __coro_main(coro_t* coro) {
+
+  coro->entry(coro->arg);
+  coro->finished = true;
+
+  __coro_leave(coro);
+}
+
+#ifdef FROST_CORO_UCONTEXT
+/**
+ * MARK: __coro_boot
+ * @brief makecontext passes int arguments only, take the coroutine being resumed
+ */
+static void __coro_boot() {
+  __coro_main(__coro_current);
+}
+
+/**
+ * MARK: __coro_context
+ * @brief build the first context, no local of the caller lives across getcontext
+ */
+static bool __coro_context(coro_t* coro) {
+
+  if(getcontext(&coro->ctx) != 0)
+    return false;
+
+  coro->ctx.uc_stack.ss_sp = coro->stack;
+  coro->ctx.uc_stack.ss_size = coro->size;
+  coro->ctx.uc_link = NULL;
+  makecontext(&coro->ctx, __coro_boot, 0);
+
+  return true;
+}
+#endif
+
+/**
+ * MARK: __coro_alloc
+ * @brief allocate a stack with the header above its top, and a guard page
+ * or the canary below its bottom
+ */
+static coro_t* __coro_alloc(size_t stack_size) {
+
+  uint8_t* _block = NULL;
+  size_t _size = 0;
+  size_t _guard = 0;
+
+  #ifdef FROST_CORO_GUARD
+  _guard = (size_t)sysconf(_SC_PAGESIZE);
+  _size = (_guard + stack_size + sizeof(coro_t) + 15 + _guard - 1) & ~(_guard - 1);
+
+  if((_block = mmap(NULL, _size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0)) == MAP_FAILED)
+    return NULL;
+
+  if(mprotect(_block, _guard, PROT_NONE) != 0) {
+    munmap(_block, _size);
+    return NULL;
+  }
+  #else
+  _guard = sizeof(uint64_t);
+  _size = _guard + stack_size + sizeof(coro_t) + 15;
+
+  if((_block = malloc(_size)) == NULL)
+    return NULL;
+
+  *(uint64_t *)_block = __CORO_CANARY;
+  #endif
+
+  // the header sits above the top of stack, the overflow grows away from it
+  coro_t* _coro = (coro_t *)((uintptr_t)(_block + _size - sizeof(coro_t)) & ~(uintptr_t)15); {
+    _coro->block = _block;
+    _coro->block_size = _size;
+    _coro->stack = _block + _guard;
+    _coro->size = (size_t)((uint8_t *)_coro - _coro->stack);
+  }
+
+  return _coro;
+}
+
+/**
+ * MARK: __coro_free
+ * @brief free the stack and its header
+ */
+static void __coro_free(coro_t* coro) {
+  #ifdef FROST_CORO_GUARD
+  munmap(coro->block, coro->block_size);
+  #else
+  free(coro->block);
+  #endif
+}
+
+/**
+ * MARK: __coro_check
+ * @brief the guard page faults on overflow, check the canary otherwise
+ */
+static void __coro_check(coro_t* coro) {
+  #ifndef FROST_CORO_GUARD
+  if(*(uint64_t *)coro->block != __CORO_CANARY) {
+    frost_log(TAG, "coroutine %p has overflowed its stack of %zu bytes", coro, coro->size);
+    abort();
+  }
+  #else
+  (void)coro;
+  #endif
+}
+
+/**
+ * MARK: coro_pool_create
+ * @brief create a stack pool
+ *
+ * @param stack_size stack size of every coroutine
+ * @param max_pooled max free stacks kept for reuse
+ * @param pool return the pool if success
+ */
+frost_errcode_t coro_pool_create(size_t stack_size, size_t max_pooled, coro_pool_t** pool) {
+
+  if(pool == NULL || stack_size < 4096)
+    return frost_err_invalid_parameter;
+
+  coro_pool_t* _pool = malloc(sizeof(coro_pool_t)); {
+    if(_pool == NULL)
+      return frost_err_out_of_memory;
+
+    _pool->free = NULL;
+    _pool->count = 0;
+    _pool->max_pooled = max_pooled;
+    _pool->stack_size = stack_size;
+  }
+
+  *pool = _pool;
+  frost_log(TAG, "coroutine stack pool created %p, stack size %zu", _pool, stack_size);
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: coro_pool_destroy
+ * @brief destroy the pool and free the stacks
+ *
+ * @param pool stack pool
+ */
+frost_errcode_t coro_pool_destroy(coro_pool_t* pool) {
+
+  if(pool == NULL)
+    return frost_err_invalid_parameter;
+
+  while(pool->free != NULL) {
+    coro_t* _next = pool->free->next;
+    __coro_free(pool->free);
+    pool->free = _next;
+  }
+
+  frost_log(TAG, "coroutine stack pool destroyed %p", pool);
+  free(pool);
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: coro_create
+ * @brief create a coroutine on a stack of the pool
+ *
+ * @param pool stack pool
+ * @param entry entry function
+ * @param arg argument of entry
+ * @param coro return the coroutine if success
+ */
+frost_errcode_t coro_create(coro_pool_t* pool, coro_entry_t entry, void* arg, coro_t** coro) {
+
+  if(pool == NULL || entry == NULL || coro == NULL)
+    return frost_err_invalid_parameter;
+
+  // reuse a pooled stack, or allocate the header together with the stack
+  coro_t* _coro = pool->free;
+  if(_coro != NULL) {
+    pool->free = _coro->next;
+    --pool->count;
+  }
+
+  else if((_coro = __coro_alloc(pool->stack_size)) == NULL) {
+    return frost_err_out_of_memory;
+  }
+
+  _coro->next = NULL;
+  _coro->caller = NULL;
+  _coro->entry = entry;
+  _coro->arg = arg;
+  _coro->running = false;
+  _coro->finished = false;
+
+  #ifdef FROST_CORO_ASM
+  _coro->sp = __coro_frame((uint8_t *)((uintptr_t)(_coro->stack + _coro->size) & ~(uintptr_t)15), __coro_main, _coro);
+  #else
+  if(!__coro_context(_coro)) {
+    __coro_free(_coro);
+    return frost_err_fatal_error;
+  }
+  #endif
+
+  *coro = _coro;
+  return frost_err_ok;
+}
+
+/**
+ * MARK: coro_resume
+ * @brief switch to the coroutine
+ *
+ * @param coro coroutine
+ */
+frost_errcode_t coro_resume(coro_t* coro) {
+
+  if(coro == NULL || coro->running || coro->finished)
+    return frost_err_invalid_parameter;
+
+  coro->caller = __coro_current;
+  coro->running = true;
+  __coro_current = coro;
+
+  #ifdef FROST_CORO_ASM
+  __frost_coro_switch(&coro->caller_sp, coro->sp);
+  #else
+  swapcontext(&coro->caller_ctx, &coro->ctx);
+  #endif
+
+  // suspended or finished
+  __coro_current = coro->caller;
+  coro->running = false;
+  __coro_check(coro);
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: coro_suspend
+ * @brief suspend current coroutine
+ */
+frost_errcode_t coro_suspend() {
+
+  coro_t* _coro = __coro_current;
+  if(_coro == NULL)
+    return frost_err_invalid_parameter;
+
+  __coro_leave(_coro);
+  return frost_err_ok;
+}
+
+/**
+ * MARK: coro_current
+ * @brief get the coroutine running on current thread
+ */
+coro_t* coro_current() {
+  return __coro_current;
+}
+
+/**
+ * MARK: coro_is_finished
+ * @brief has the entry of coroutine returned
+ *
+ * @param coro coroutine
+ */
+bool coro_is_finished(coro_t* coro) {
+  return coro == NULL || coro->finished;
+}
+
+/**
+ * MARK: coro_release
+ * @brief give the stack back to the pool
+ *
+ * @param pool stack pool
+ * @param coro coroutine
+ */
+frost_errcode_t coro_release(coro_pool_t* pool, coro_t* coro) {
+
+  if(pool == NULL || coro == NULL || coro->running)
+    return frost_err_invalid_parameter;
+
+  if(pool->count >= pool->max_pooled) {
+    __coro_free(coro);
+    return frost_err_ok;
+  }
+
+  coro->next = pool->free;
+  pool->free = coro;
+  ++pool->count;
+
+  return frost_err_ok;
+}
+
+#endif /* FROST_HAS_CORO */
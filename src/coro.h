@@ -0,0 +1,137 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#ifndef _FROST_CORO_H
+#define _FROST_CORO_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "common.h"
+
+/**
+ * @brief stack size of every stackful task
+ */
+#ifndef FROST_CORO_STACK_SIZE
+  #define FROST_CORO_STACK_SIZE (64 * 1024)
+#endif
+
+/**
+ * @brief max stacks kept by the pool of an engine after their tasks return
+ */
+#ifndef FROST_CORO_POOL_SIZE
+  #define FROST_CORO_POOL_SIZE 16
+#endif
+
+/**
+ * @brief the context switch, hand-written for x86-64 and aarch64,
+ * ucontext for the other unix platforms. define FROST_CORO_UCONTEXT to force ucontext,
+ * or FROST_NO_CORO to disable the stackful tasks
+ */
+#if !defined(FROST_NO_CORO) && !defined(FROST_CORO_UCONTEXT) && !defined(_WIN32) && \
+    defined(__GNUC__) && (defined(__x86_64__) || defined(__aarch64__))
+  #define FROST_CORO_ASM
+  #define FROST_HAS_CORO
+#elif !defined(FROST_NO_CORO) && (defined(__unix__) || defined(__APPLE__))
+  #ifndef FROST_CORO_UCONTEXT
+    #define FROST_CORO_UCONTEXT
+  #endif
+  #define FROST_HAS_CORO
+#endif
+
+/**
+ * @brief put an inaccessible guard page below every stack, a stack overflow faults
+ * instead of overwriting the memory next to it. define FROST_CORO_NO_GUARD to take
+ * the stacks from malloc, the overflow is detected by a canary when it switches back
+ */
+#if defined(FROST_HAS_CORO) && !defined(FROST_CORO_NO_GUARD) && (defined(__unix__) || defined(__APPLE__))
+  #define FROST_CORO_GUARD
+#endif
+
+typedef void (* coro_entry_t)(void* arg);
+
+typedef struct _coro_t coro_t;
+typedef struct _coro_pool_t coro_pool_t;
+
+#ifdef FROST_HAS_CORO
+
+/**
+ * @brief create a stack pool
+ *
+ * @param stack_size stack size of every coroutine
+ * @param max_pooled max free stacks kept for reuse
+ * @param pool return the pool if success
+ * @return frost_errcode_t
+ */
+frost_errcode_t coro_pool_create(size_t stack_size, size_t max_pooled, coro_pool_t** pool);
+
+/**
+ * @brief destroy the pool and free the stacks. the coroutines not released
+ * are owned by the caller
+ *
+ * @param pool stack pool
+ * @return frost_errcode_t
+ */
+frost_errcode_t coro_pool_destroy(coro_pool_t* pool);
+
+/**
+ * @brief create a coroutine on a stack of the pool, it starts at the first resume
+ *
+ * @param pool stack pool
+ * @param entry entry function
+ * @param arg argument of entry
+ * @param coro return the coroutine if success
+ * @return frost_errcode_t
+ */
+frost_errcode_t coro_create(coro_pool_t* pool, coro_entry_t entry, void* arg, coro_t** coro);
+
+/**
+ * @brief switch to the coroutine, returns when it suspends or its entry returns
+ *
+ * @param coro coroutine
+ * @return frost_errcode_t if the coroutine has finished return frost_err_invalid_parameter
+ */
+frost_errcode_t coro_resume(coro_t* coro);
+
+/**
+ * @brief suspend current coroutine, switch back to the resumer
+ *
+ * @return frost_errcode_t if not in a coroutine return frost_err_invalid_parameter
+ */
+frost_errcode_t coro_suspend();
+
+/**
+ * @brief get the coroutine running on current thread
+ *
+ * @return coro_t* NULL if on the thread stack
+ */
+coro_t* coro_current();
+
+/**
+ * @brief has the entry of coroutine returned
+ *
+ * @param coro coroutine
+ * @return bool
+ */
+bool coro_is_finished(coro_t* coro);
+
+/**
+ * @brief give the stack back to the pool. a suspended coroutine is abandoned
+ * without unwinding, the resources held by its frames are leaked
+ *
+ * @param pool stack pool
+ * @param coro coroutine, must not be running
+ * @return frost_errcode_t
+ */
+frost_errcode_t coro_release(coro_pool_t* pool, coro_t* coro);
+
+#endif /* FROST_HAS_CORO */
+
+#endif /* _FROST_CORO_H */
@@ -0,0 +1,208 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "../common.h"
+#include "../log.h"
+#include "aring.h"
+
+#ifdef FROST_HAS_ATOMICS
+
+/**
+ * MARK: aring_create
+ * @brief create a bounded ring buffer shared between threads
+ *
+ * @param capacity capacity
+ * @param mode producer mode
+ * @param ctx return ring context if success
+ */
+frost_errcode_t aring_create(size_t capacity, aring_mode_t mode, aring_ctx_t** ctx) {
+
+  if(ctx == NULL || capacity == 0)
+    return frost_err_invalid_parameter;
+
+  size_t _capacity = 2;
+  while(_capacity < capacity) _capacity <<= 1;
+
+  aring_ctx_t* _ctx = malloc(sizeof(aring_ctx_t) + _capacity * sizeof(aring_slot_t)); {
+    if(_ctx == NULL)
+      return frost_err_out_of_memory;
+
+    memset(_ctx, 0, sizeof(aring_ctx_t));
+    atomic_init(&_ctx->head, 0);
+    atomic_init(&_ctx->tail, 0);
+    _ctx->mode = mode;
+    _ctx->mask = _capacity - 1;
+
+    for(size_t i = 0; i < _capacity; ++i) {
+      atomic_init(&_ctx->slots[i].seq, i);
+      _ctx->slots[i].data = NULL;
+    }
+  }
+
+  *ctx = _ctx;
+  frost_log(TAG, "atomic ring created %p, capacity %zu", _ctx, _capacity);
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: aring_push
+ * @brief push an item
+ *
+ * @param ctx ring context pointer
+ * @param data the item
+ */
+frost_errcode_t aring_push(aring_ctx_t* ctx, void* data) {
+
+  if(ctx == NULL)
+    return frost_err_invalid_parameter;
+
+  size_t _pos = atomic_load_explicit(&ctx->tail, memory_order_relaxed);
+  aring_slot_t* _slot;
+
+  while(true) {
+
+    _slot = &ctx->slots[_pos & ctx->mask];
+    size_t _seq = atomic_load_explicit(&_slot->seq, memory_order_acquire);
+    intptr_t _diff = (intptr_t)_seq - (intptr_t)_pos;
+
+    // the consumer has not released the slot of last round
+    if(_diff < 0)
+      return frost_err_full;
+
+    // the only producer owns the tail
+    if(ctx->mode == aring_spsc) {
+      atomic_store_explicit(&ctx->tail, _pos + 1, memory_order_relaxed);
+      break;
+    }
+
+    // claim the slot
+    if(_diff == 0) {
+      if(atomic_compare_exchange_weak_explicit(&ctx->tail, &_pos, _pos + 1,
+         memory_order_relaxed, memory_order_relaxed))
+        break;
+    }
+
+    // another producer has claimed it
+    else {
+      _pos = atomic_load_explicit(&ctx->tail, memory_order_relaxed);
+    }
+  }
+
+  // publish
+  _slot->data = data;
+  atomic_store_explicit(&_slot->seq, _pos + 1, memory_order_release);
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: aring_pop
+ * @brief pop an item
+ *
+ * @param ctx ring context pointer
+ * @param data return the item
+ */
+frost_errcode_t aring_pop(aring_ctx_t* ctx, void** data) {
+
+  if(ctx == NULL || data == NULL)
+    return frost_err_invalid_parameter;
+
+  size_t _pos = atomic_load_explicit(&ctx->head, memory_order_relaxed);
+  aring_slot_t* _slot = &ctx->slots[_pos & ctx->mask];
+
+  // empty, or the producer claimed the slot has not published yet
+  if(atomic_load_explicit(&_slot->seq, memory_order_acquire) != _pos + 1)
+    return frost_err_eof;
+
+  *data = _slot->data;
+
+  // release the slot for next round
+  atomic_store_explicit(&_slot->seq, _pos + ctx->mask + 1, memory_order_release);
+  atomic_store_explicit(&ctx->head, _pos + 1, memory_order_relaxed);
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: aring_pop_many
+ * @brief pop up to max items
+ *
+ * @param ctx ring context pointer
+ * @param data return the items
+ * @param max max item count
+ * @param count return the count popped
+ */
+frost_errcode_t aring_pop_many(aring_ctx_t* ctx, void** data, size_t max, size_t* count) {
+
+  if(ctx == NULL || data == NULL || count == NULL)
+    return frost_err_invalid_parameter;
+
+  size_t _pos = atomic_load_explicit(&ctx->head, memory_order_relaxed);
+  size_t _count = 0;
+
+  // stop at the first slot not published
+  for(; _count < max; ++_count) {
+
+    aring_slot_t* _slot = &ctx->slots[(_pos + _count) & ctx->mask];
+    if(atomic_load_explicit(&_slot->seq, memory_order_acquire) != _pos + _count + 1)
+      break;
+
+    data[_count] = _slot->data;
+    atomic_store_explicit(&_slot->seq, _pos + _count + ctx->mask + 1, memory_order_release);
+  }
+
+  *count = _count;
+  if(_count == 0)
+    return frost_err_eof;
+
+  // one head update for the batch
+  atomic_store_explicit(&ctx->head, _pos + _count, memory_order_relaxed);
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: aring_size
+ * @brief get the approximate item count
+ *
+ * @param ctx ring context pointer
+ */
+size_t aring_size(aring_ctx_t* ctx) {
+
+  if(ctx == NULL)
+    return 0;
+
+  size_t _tail = atomic_load_explicit(&ctx->tail, memory_order_relaxed);
+  size_t _head = atomic_load_explicit(&ctx->head, memory_order_relaxed);
+  return _tail > _head ? _tail - _head : 0;
+}
+
+/**
+ * MARK: aring_destroy
+ * @brief destroy ring
+ *
+ * @param ctx ring context pointer
+ */
+frost_errcode_t aring_destroy(aring_ctx_t* ctx) {
+
+  if(ctx == NULL)
+    return frost_err_invalid_parameter;
+
+  frost_log(TAG, "atomic ring destroyed %p", ctx);
+  free(ctx);
+
+  return frost_err_ok;
+}
+
+#endif /* FROST_HAS_ATOMICS */
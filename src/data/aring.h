@@ -0,0 +1,103 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#ifndef _FROST_DATA_ARING_H
+#define _FROST_DATA_ARING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "../common.h"
+
+#ifdef FROST_HAS_ATOMICS
+
+#include <stdatomic.h>
+
+/**
+ * @brief producer mode of atomic ring
+ */
+typedef enum {
+  aring_spsc, /* one producer thread, no compare-and-swap on push */
+  aring_mpsc, /* producers from any thread */
+} aring_mode_t;
+
+typedef struct _aring_slot_t {
+  _Atomic(size_t) seq; /* equals to the position when writable, position + 1 when readable */
+  void* data;
+} aring_slot_t;
+
+typedef struct _aring_ctx_t {
+  _Atomic(size_t) head; /* consumer position */
+  char __pad0[FROST_CACHE_LINE - sizeof(size_t)];
+  _Atomic(size_t) tail; /* producer position */
+  char __pad1[FROST_CACHE_LINE - sizeof(size_t)];
+  aring_mode_t mode;
+  size_t mask;
+  aring_slot_t slots[];
+} aring_ctx_t;
+
+/**
+ * @brief create a bounded single-consumer ring buffer shared between threads
+ *
+ * @param capacity capacity, rounded up to power of two
+ * @param mode producer mode
+ * @param ctx return ring context if success
+ * @return frost_errcode_t
+ */
+frost_errcode_t aring_create(size_t capacity, aring_mode_t mode, aring_ctx_t** ctx);
+
+/**
+ * @brief push an item, producer only. lock-free
+ *
+ * @param ctx ring context pointer
+ * @param data the item
+ * @return frost_errcode_t if ring is full return frost_err_full
+ */
+frost_errcode_t aring_push(aring_ctx_t* ctx, void* data);
+
+/**
+ * @brief pop an item, consumer only. wait-free
+ *
+ * @param ctx ring context pointer
+ * @param data return the item
+ * @return frost_errcode_t if nothing is published return frost_err_eof
+ */
+frost_errcode_t aring_pop(aring_ctx_t* ctx, void** data);
+
+/**
+ * @brief pop up to max items in order, consumer only. wait-free
+ *
+ * @param ctx ring context pointer
+ * @param data return the items
+ * @param max max item count
+ * @param count return the count popped
+ * @return frost_errcode_t if nothing is published return frost_err_eof
+ */
+frost_errcode_t aring_pop_many(aring_ctx_t* ctx, void** data, size_t max, size_t* count);
+
+/**
+ * @brief get the approximate item count
+ *
+ * @param ctx ring context pointer
+ * @return size_t
+ */
+size_t aring_size(aring_ctx_t* ctx);
+
+/**
+ * @brief destroy ring, the remaining items are owned by the caller and will not be touched
+ *
+ * @param ctx ring context pointer
+ * @return frost_errcode_t
+ */
+frost_errcode_t aring_destroy(aring_ctx_t* ctx);
+
+#endif /* FROST_HAS_ATOMICS */
+
+#endif /* _FROST_DATA_ARING_H */
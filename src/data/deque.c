@@ -0,0 +1,248 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "../common.h"
+#include "../log.h"
+#include "deque.h"
+
+#ifdef FROST_HAS_ATOMICS
+
+#define DEQUE_MIN_CAPACITY 16
+
+/**
+ * MARK: __deque_array_create
+ * @brief allocate a ring array, the capacity must be power of two
+ */
+static deque_array_t* __deque_array_create(size_t capacity) {
+
+  deque_array_t* _array = malloc(sizeof(deque_array_t) + capacity * sizeof(_Atomic(void*))); {
+    if(_array == NULL)
+      return NULL;
+
+    _array->retired = NULL;
+    _array->mask = capacity - 1;
+    for(size_t i = 0; i < capacity; ++i) {
+      atomic_init(&_array->items[i], NULL);
+    }
+  }
+
+  return _array;
+}
+
+/**
+ * MARK: __deque_grow
+ * @brief double the ring array, owner only.
+ * the thieves may still read the old array, so it is retired instead of freed
+ */
+static deque_array_t* __deque_grow(deque_ctx_t* ctx, deque_array_t* array, int64_t top, int64_t bottom) {
+
+  deque_array_t* _array = __deque_array_create((array->mask + 1) << 1); {
+    if(_array == NULL)
+      return NULL;
+
+    for(int64_t i = top; i < bottom; ++i) {
+      void* _item = atomic_load_explicit(&array->items[i & array->mask], memory_order_relaxed);
+      atomic_store_explicit(&_array->items[i & _array->mask], _item, memory_order_relaxed);
+    }
+
+    _array->retired = array;
+  }
+
+  atomic_store_explicit(&ctx->array, _array, memory_order_release);
+  frost_log(TAG, "deque %p grows to %zu", ctx, _array->mask + 1);
+
+  return _array;
+}
+
+/**
+ * MARK: deque_create
+ * @brief create a new work-stealing deque
+ *
+ * @param capacity initialize capacity
+ * @param ctx return deque context if success
+ */
+frost_errcode_t deque_create(size_t capacity, deque_ctx_t** ctx) {
+
+  if(ctx == NULL)
+    return frost_err_invalid_parameter;
+
+  size_t _capacity = DEQUE_MIN_CAPACITY;
+  while(_capacity < capacity) _capacity <<= 1;
+
+  deque_ctx_t* _ctx = malloc(sizeof(deque_ctx_t)); {
+    if(_ctx == NULL)
+      return frost_err_out_of_memory;
+
+    memset(_ctx, 0, sizeof(deque_ctx_t));
+    atomic_init(&_ctx->top, 0);
+    atomic_init(&_ctx->bottom, 0);
+  }
+
+  deque_array_t* _array = __deque_array_create(_capacity); {
+    if(_array == NULL) {
+      free(_ctx);
+      return frost_err_out_of_memory;
+    }
+
+    atomic_init(&_ctx->array, _array);
+  }
+
+  *ctx = _ctx;
+  frost_log(TAG, "deque created %p", _ctx);
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: deque_push
+ * @brief push an item at the bottom, owner only
+ *
+ * @param ctx deque context pointer
+ * @param data the item
+ */
+frost_errcode_t deque_push(deque_ctx_t* ctx, void* data) {
+
+  if(ctx == NULL || data == NULL)
+    return frost_err_invalid_parameter;
+
+  int64_t _bottom = atomic_load_explicit(&ctx->bottom, memory_order_relaxed);
+  int64_t _top = atomic_load_explicit(&ctx->top, memory_order_acquire);
+  deque_array_t* _array = atomic_load_explicit(&ctx->array, memory_order_relaxed);
+
+  // the ring array is full
+  if(_bottom - _top > (int64_t)_array->mask) {
+    if((_array = __deque_grow(ctx, _array, _top, _bottom)) == NULL)
+      return frost_err_out_of_memory;
+  }
+
+  atomic_store_explicit(&_array->items[_bottom & _array->mask], data, memory_order_relaxed);
+  atomic_thread_fence(memory_order_release);
+  atomic_store_explicit(&ctx->bottom, _bottom + 1, memory_order_relaxed);
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: deque_pop
+ * @brief pop an item from the bottom, owner only
+ *
+ * @param ctx deque context pointer
+ * @param data return the item
+ */
+frost_errcode_t deque_pop(deque_ctx_t* ctx, void** data) {
+
+  if(ctx == NULL || data == NULL)
+    return frost_err_invalid_parameter;
+
+  // reserve the bottom item first, then check the thieves
+  int64_t _bottom = atomic_load_explicit(&ctx->bottom, memory_order_relaxed) - 1;
+  deque_array_t* _array = atomic_load_explicit(&ctx->array, memory_order_relaxed);
+  atomic_store_explicit(&ctx->bottom, _bottom, memory_order_relaxed);
+  atomic_thread_fence(memory_order_seq_cst);
+  int64_t _top = atomic_load_explicit(&ctx->top, memory_order_relaxed);
+
+  // empty
+  if(_top > _bottom) {
+    atomic_store_explicit(&ctx->bottom, _bottom + 1, memory_order_relaxed);
+    return frost_err_eof;
+  }
+
+  void* _item = atomic_load_explicit(&_array->items[_bottom & _array->mask], memory_order_relaxed);
+
+  // the last item, race with the thieves
+  if(_top == _bottom) {
+    bool _won = atomic_compare_exchange_strong_explicit(&ctx->top, &_top, _top + 1,
+                memory_order_seq_cst, memory_order_relaxed);
+    atomic_store_explicit(&ctx->bottom, _bottom + 1, memory_order_relaxed);
+    if(!_won) return frost_err_eof;
+  }
+
+  *data = _item;
+  return frost_err_ok;
+}
+
+/**
+ * MARK: deque_steal
+ * @brief steal an item from the top
+ *
+ * @param ctx deque context pointer
+ * @param data return the item
+ */
+frost_errcode_t deque_steal(deque_ctx_t* ctx, void** data) {
+
+  if(ctx == NULL || data == NULL)
+    return frost_err_invalid_parameter;
+
+  while(true) {
+
+    int64_t _top = atomic_load_explicit(&ctx->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t _bottom = atomic_load_explicit(&ctx->bottom, memory_order_acquire);
+
+    if(_top >= _bottom)
+      return frost_err_eof;
+
+    deque_array_t* _array = atomic_load_explicit(&ctx->array, memory_order_acquire);
+    void* _item = atomic_load_explicit(&_array->items[_top & _array->mask], memory_order_relaxed);
+
+    // another thief or the owner took it, try again
+    if(!atomic_compare_exchange_strong_explicit(&ctx->top, &_top, _top + 1,
+        memory_order_seq_cst, memory_order_relaxed))
+      continue;
+
+    *data = _item;
+    return frost_err_ok;
+  }
+}
+
+/**
+ * MARK: deque_size
+ * @brief get the approximate item count
+ *
+ * @param ctx deque context pointer
+ */
+size_t deque_size(deque_ctx_t* ctx) {
+
+  if(ctx == NULL)
+    return 0;
+
+  int64_t _bottom = atomic_load_explicit(&ctx->bottom, memory_order_relaxed);
+  int64_t _top = atomic_load_explicit(&ctx->top, memory_order_relaxed);
+  return _bottom > _top ? (size_t)(_bottom - _top) : 0;
+}
+
+/**
+ * MARK: deque_destroy
+ * @brief destroy deque
+ *
+ * @param ctx deque context pointer
+ */
+frost_errcode_t deque_destroy(deque_ctx_t* ctx) {
+
+  if(ctx == NULL)
+    return frost_err_invalid_parameter;
+
+  deque_array_t* _array = atomic_load_explicit(&ctx->array, memory_order_relaxed);
+  while(_array) {
+    deque_array_t* _retired = _array->retired;
+    free(_array);
+    _array = _retired;
+  }
+
+  frost_log(TAG, "deque destroyed %p", ctx);
+  free(ctx);
+
+  return frost_err_ok;
+}
+
+#endif /* FROST_HAS_ATOMICS */
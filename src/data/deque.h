@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#ifndef _FROST_DATA_DEQUE_H
+#define _FROST_DATA_DEQUE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "../common.h"
+
+#ifdef FROST_HAS_ATOMICS
+
+#include <stdatomic.h>
+
+typedef struct _deque_array_t {
+  struct _deque_array_t* retired; /* the smaller arrays, freed when deque destroyed */
+  size_t mask;
+  _Atomic(void*) items[];
+} deque_array_t;
+
+typedef struct _deque_ctx_t {
+  _Atomic(int64_t) top;
+  char __pad0[FROST_CACHE_LINE - sizeof(int64_t)];
+  _Atomic(int64_t) bottom;
+  char __pad1[FROST_CACHE_LINE - sizeof(int64_t)];
+  _Atomic(deque_array_t*) array;
+} deque_ctx_t;
+
+/**
+ * @brief create a new work-stealing deque (Chase-Lev).
+ * the owner pushes and pops at the bottom, the thieves steal from the top
+ *
+ * @param capacity initialize capacity, rounded up to power of two, the deque grows automatically
+ * @param ctx return deque context if success
+ * @return frost_errcode_t
+ */
+frost_errcode_t deque_create(size_t capacity, deque_ctx_t** ctx);
+
+/**
+ * @brief push an item at the bottom, owner only. O(1)
+ *
+ * @param ctx deque context pointer
+ * @param data the item, must not be NULL
+ * @return frost_errcode_t
+ */
+frost_errcode_t deque_push(deque_ctx_t* ctx, void* data);
+
+/**
+ * @brief pop an item from the bottom, owner only. O(1)
+ *
+ * @param ctx deque context pointer
+ * @param data return the item
+ * @return frost_errcode_t if deque is empty return frost_err_eof
+ */
+frost_errcode_t deque_pop(deque_ctx_t* ctx, void** data);
+
+/**
+ * @brief steal an item from the top, safe to call from any thread. O(1)
+ *
+ * @param ctx deque context pointer
+ * @param data return the item
+ * @return frost_errcode_t if deque is empty return frost_err_eof
+ */
+frost_errcode_t deque_steal(deque_ctx_t* ctx, void** data);
+
+/**
+ * @brief get the approximate item count
+ *
+ * @param ctx deque context pointer
+ * @return size_t
+ */
+size_t deque_size(deque_ctx_t* ctx);
+
+/**
+ * @brief destroy deque, the remaining items are owned by the caller and will not be touched
+ *
+ * @param ctx deque context pointer
+ * @return frost_errcode_t
+ */
+frost_errcode_t deque_destroy(deque_ctx_t* ctx);
+
+#endif /* FROST_HAS_ATOMICS */
+
+#endif /* _FROST_DATA_DEQUE_H */
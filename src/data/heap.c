@@ -0,0 +1,237 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "../common.h"
+#include "../log.h"
+#include "heap.h"
+
+/**
+ * MARK: __heap_set
+ * @brief put node at the position
+ */
+static void __heap_set(heap_ctx_t* ctx, size_t pos, heap_node_t* node, int64_t key) {
+  ctx->items[pos] = node;
+  ctx->keys[pos] = key;
+  node->index = pos + 1;
+}
+
+/**
+ * MARK: __heap_sift_up
+ * @brief move node at the position up until the parent is smaller
+ */
+static void __heap_sift_up(heap_ctx_t* ctx, size_t pos) {
+
+  heap_node_t* _node = ctx->items[pos];
+  int64_t _key = ctx->keys[pos];
+  while(pos > 0) {
+    size_t _parent = (pos - 1) / FROST_HEAP_ARITY;
+    if(ctx->keys[_parent] <= _key) break;
+
+    __heap_set(ctx, pos, ctx->items[_parent], ctx->keys[_parent]);
+    pos = _parent;
+  }
+
+  __heap_set(ctx, pos, _node, _key);
+}
+
+/**
+ * MARK: __heap_sift_down
+ * @brief move node at the position down until all children are bigger
+ */
+static void __heap_sift_down(heap_ctx_t* ctx, size_t pos) {
+
+  heap_node_t* _node = ctx->items[pos];
+  int64_t _key = ctx->keys[pos];
+  while(true) {
+
+    // find the smallest child
+    size_t _first = pos * FROST_HEAP_ARITY + 1;
+    if(_first >= ctx->size) break;
+
+    size_t _last = _first + FROST_HEAP_ARITY;
+    if(_last > ctx->size) _last = ctx->size;
+
+    // the children keys are adjacent, mostly in one cache line
+    size_t _min = _first;
+    for(size_t i = _first + 1; i < _last; ++i) {
+      if(ctx->keys[i] < ctx->keys[_min]) _min = i;
+    }
+
+    if(_key <= ctx->keys[_min]) break;
+
+    __heap_set(ctx, pos, ctx->items[_min], ctx->keys[_min]);
+    pos = _min;
+  }
+
+  __heap_set(ctx, pos, _node, _key);
+}
+
+/**
+ * MARK: heap_create
+ * @brief create a new min-heap
+ *
+ * @param capacity initialize capacity
+ * @param ctx return heap context if success
+ */
+frost_errcode_t heap_create(size_t capacity, heap_ctx_t** ctx) {
+
+  if(ctx == NULL)
+    return frost_err_invalid_parameter;
+
+  if(capacity == 0)
+    capacity = 16;
+
+  heap_ctx_t* _ctx = malloc(sizeof(heap_ctx_t)); {
+    if(_ctx == NULL)
+      return frost_err_out_of_memory;
+    memset(_ctx, 0, sizeof(heap_ctx_t));
+  }
+
+  _ctx->items = malloc(capacity * sizeof(heap_node_t *));
+  _ctx->keys = malloc(capacity * sizeof(int64_t)); {
+    if(_ctx->items == NULL || _ctx->keys == NULL) {
+      free(_ctx->items);
+      free(_ctx->keys);
+      free(_ctx);
+      return frost_err_out_of_memory;
+    }
+  }
+
+  _ctx->capacity = capacity;
+  *ctx = _ctx;
+
+  frost_log(TAG, "heap created %p", _ctx);
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: heap_push
+ * @brief push node into heap
+ *
+ * @param ctx heap context pointer
+ * @param node heap node
+ * @param key the key
+ */
+frost_errcode_t heap_push(heap_ctx_t* ctx, heap_node_t* node, int64_t key) {
+
+  if(ctx == NULL || node == NULL || node->index != 0)
+    return frost_err_invalid_parameter;
+
+  // grow the storage
+  if(ctx->size == ctx->capacity) {
+    size_t _capacity = ctx->capacity * 2;
+    heap_node_t** _items = realloc(ctx->items, _capacity * sizeof(heap_node_t *)); {
+      if(_items == NULL)
+        return frost_err_out_of_memory;
+      ctx->items = _items;
+    }
+
+    int64_t* _keys = realloc(ctx->keys, _capacity * sizeof(int64_t)); {
+      if(_keys == NULL)
+        return frost_err_out_of_memory;
+      ctx->keys = _keys;
+    }
+
+    ctx->capacity = _capacity;
+  }
+
+  node->key = key;
+  __heap_set(ctx, ctx->size++, node, key);
+  __heap_sift_up(ctx, ctx->size - 1);
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: heap_pop
+ * @brief pop the node with smallest key
+ *
+ * @param ctx heap context pointer
+ * @param node return the node
+ */
+frost_errcode_t heap_pop(heap_ctx_t* ctx, heap_node_t** node) {
+
+  if(ctx == NULL || node == NULL)
+    return frost_err_invalid_parameter;
+
+  if(ctx->size == 0) {
+    *node = NULL;
+    return frost_err_eof;
+  }
+
+  *node = ctx->items[0];
+  return heap_delete(ctx, ctx->items[0]);
+}
+
+/**
+ * MARK: heap_delete
+ * @brief delete a node from heap
+ *
+ * @param ctx heap context pointer
+ * @param node heap node
+ */
+frost_errcode_t heap_delete(heap_ctx_t* ctx, heap_node_t* node) {
+
+  if(ctx == NULL || node == NULL)
+    return frost_err_invalid_parameter;
+
+  if(node->index == 0)
+    return frost_err_ok;
+
+  size_t _pos = node->index - 1;
+  node->index = 0;
+
+  // fill the hole with the last node
+  heap_node_t* _last = ctx->items[--ctx->size];
+  int64_t _key = ctx->keys[ctx->size];
+  if(_pos == ctx->size)
+    return frost_err_ok;
+
+  __heap_set(ctx, _pos, _last, _key);
+  if(_pos > 0 && ctx->keys[(_pos - 1) / FROST_HEAP_ARITY] > _key)
+    __heap_sift_up(ctx, _pos);
+  else
+    __heap_sift_down(ctx, _pos);
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: heap_is_queued
+ * @brief is node in a heap
+ *
+ * @param node heap node
+ */
+bool heap_is_queued(heap_node_t* node) {
+  return node != NULL && node->index != 0;
+}
+
+/**
+ * MARK: heap_destroy
+ * @brief destroy heap
+ *
+ * @param ctx heap context pointer
+ */
+frost_errcode_t heap_destroy(heap_ctx_t* ctx) {
+
+  if(ctx == NULL)
+    return frost_err_invalid_parameter;
+
+  frost_log(TAG, "heap destroyed %p", ctx);
+  free(ctx->items);
+  free(ctx->keys);
+  free(ctx);
+
+  return frost_err_ok;
+}
@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#ifndef _FROST_DATA_HEAP_H
+#define _FROST_DATA_HEAP_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief heap arity, every node has FROST_HEAP_ARITY children
+ */
+#ifndef FROST_HEAP_ARITY
+  #define FROST_HEAP_ARITY 4
+#endif
+
+typedef struct _heap_node_t {
+  int64_t key;
+  size_t index; /* position + 1, zero means not in heap */
+  void* data;
+} heap_node_t;
+
+typedef struct _heap_ctx_t {
+  heap_node_t** items;
+  int64_t* keys; /* the keys of items packed densely, the sifts compare without touching the nodes */
+  size_t size;
+  size_t capacity;
+} heap_ctx_t;
+
+/**
+ * @brief create a new min-heap
+ *
+ * @param capacity initialize capacity, the heap grows automatically
+ * @param ctx return heap context if success
+ * @return frost_errcode_t
+ */
+frost_errcode_t heap_create(size_t capacity, heap_ctx_t** ctx);
+
+/**
+ * @brief push node into heap. O(log n)
+ *
+ * @param ctx heap context pointer
+ * @param node heap node, the node must not in any heap
+ * @param key the key, smaller key pops first
+ * @return frost_errcode_t
+ */
+frost_errcode_t heap_push(heap_ctx_t* ctx, heap_node_t* node, int64_t key);
+
+/**
+ * @brief pop the node with smallest key. O(log n)
+ *
+ * @param ctx heap context pointer
+ * @param node return the node, NULL if heap is empty
+ * @return frost_errcode_t if heap is empty return frost_err_eof
+ */
+frost_errcode_t heap_pop(heap_ctx_t* ctx, heap_node_t** node);
+
+/**
+ * @brief delete a node from heap. O(log n)
+ *
+ * @param ctx heap context pointer
+ * @param node heap node
+ * @return frost_errcode_t
+ */
+frost_errcode_t heap_delete(heap_ctx_t* ctx, heap_node_t* node);
+
+/**
+ * @brief is node in a heap
+ *
+ * @param node heap node
+ * @return in heap return true
+ */
+bool heap_is_queued(heap_node_t* node);
+
+/**
+ * @brief destroy heap, the nodes are owned by the caller and will not be touched
+ *
+ * @param ctx heap context pointer
+ * @return frost_errcode_t
+ */
+frost_errcode_t heap_destroy(heap_ctx_t* ctx);
+
+#endif /* _FROST_DATA_HEAP_H */
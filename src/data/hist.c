@@ -0,0 +1,172 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "../common.h"
+#include "../log.h"
+#include "hist.h"
+
+/**
+ * MARK: __hist_msb
+ * @brief get the index of the most significant bit, the value is not 0
+ */
+static uint32_t __hist_msb(uint64_t value) {
+  #if defined(__GNUC__)
+  return 63 - (uint32_t)__builtin_clzll(value);
+  #else
+  uint32_t _msb = 0;
+  while(value >>= 1) ++_msb;
+  return _msb;
+  #endif
+}
+
+/**
+ * MARK: __hist_index
+ * @brief get the bucket of a value
+ */
+static uint32_t __hist_index(uint64_t value) {
+
+  if(value < HIST_SUB_COUNT)
+    return (uint32_t)value;
+
+  if(value >> HIST_MAX_BITS)
+    return HIST_BUCKETS - 1;
+
+  // the leading bits below the most significant one pick the sub-bucket
+  uint32_t _msb = __hist_msb(value);
+  uint32_t _sub = (uint32_t)(value >> (_msb - HIST_SUB_BITS)) & (HIST_SUB_COUNT - 1);
+  return (_msb - HIST_SUB_BITS + 1) * HIST_SUB_COUNT + _sub;
+}
+
+/**
+ * MARK: __hist_highest
+ * @brief get the highest value of a bucket
+ */
+static uint64_t __hist_highest(uint32_t index) {
+
+  if(index < HIST_SUB_COUNT)
+    return index;
+
+  uint32_t _shift = index / HIST_SUB_COUNT - 1;
+  uint64_t _lowest = (uint64_t)(HIST_SUB_COUNT + index % HIST_SUB_COUNT) << _shift;
+  return _lowest + ((uint64_t)1 << _shift) - 1;
+}
+
+/**
+ * MARK: hist_create
+ * @brief create a log-bucketed histogram
+ *
+ * @param ctx return histogram context if success
+ */
+frost_errcode_t hist_create(hist_ctx_t** ctx) {
+
+  if(ctx == NULL)
+    return frost_err_invalid_parameter;
+
+  hist_ctx_t* _ctx = malloc(sizeof(hist_ctx_t)); {
+    if(_ctx == NULL)
+      return frost_err_out_of_memory;
+
+    memset(_ctx, 0, sizeof(hist_ctx_t));
+  }
+
+  *ctx = _ctx;
+  return frost_err_ok;
+}
+
+/**
+ * MARK: hist_record
+ * @brief record a value
+ *
+ * @param ctx histogram context pointer
+ * @param value the value
+ */
+frost_errcode_t hist_record(hist_ctx_t* ctx, uint64_t value) {
+
+  if(ctx == NULL)
+    return frost_err_invalid_parameter;
+
+  uint32_t _index = __hist_index(value);
+  if(ctx->buckets[_index] == UINT32_MAX)
+    return frost_err_full;
+
+  ctx->buckets[_index]++;
+  ctx->count++;
+  if(value > ctx->max) ctx->max = value;
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: hist_quantile
+ * @brief get the value at a quantile
+ *
+ * @param ctx histogram context pointer
+ * @param ppm the quantile in ppm
+ * @param value return the value
+ */
+frost_errcode_t hist_quantile(hist_ctx_t* ctx, uint32_t ppm, uint64_t* value) {
+
+  if(ctx == NULL || value == NULL || ppm > 1000000)
+    return frost_err_invalid_parameter;
+
+  if(ctx->count == 0)
+    return frost_err_eof;
+
+  // the rank of the quantile, rounded up and 1 at least
+  uint64_t _rank = (ctx->count * ppm + 999999) / 1000000;
+  if(_rank == 0) _rank = 1;
+
+  uint64_t _seen = 0;
+  for(uint32_t i = 0; i < HIST_BUCKETS; ++i) {
+    _seen += ctx->buckets[i];
+    if(_seen >= _rank) {
+      // the last bucket is open ended
+      uint64_t _highest = i == HIST_BUCKETS - 1 ? ctx->max : __hist_highest(i);
+      *value = _highest < ctx->max ? _highest : ctx->max;
+      return frost_err_ok;
+    }
+  }
+
+  *value = ctx->max;
+  return frost_err_ok;
+}
+
+/**
+ * MARK: hist_reset
+ * @brief clear the recorded values
+ *
+ * @param ctx histogram context pointer
+ */
+frost_errcode_t hist_reset(hist_ctx_t* ctx) {
+
+  if(ctx == NULL)
+    return frost_err_invalid_parameter;
+
+  memset(ctx, 0, sizeof(hist_ctx_t));
+  return frost_err_ok;
+}
+
+/**
+ * MARK: hist_destroy
+ * @brief destroy histogram
+ *
+ * @param ctx histogram context pointer
+ */
+frost_errcode_t hist_destroy(hist_ctx_t* ctx) {
+
+  if(ctx == NULL)
+    return frost_err_invalid_parameter;
+
+  free(ctx);
+  return frost_err_ok;
+}
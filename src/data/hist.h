@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#ifndef _FROST_DATA_HIST_H
+#define _FROST_DATA_HIST_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "../common.h"
+
+/**
+ * @brief sub-buckets per power of two are 1 << HIST_SUB_BITS, the
+ * relative error of a recorded value is 1 / (1 << HIST_SUB_BITS) at most
+ */
+#ifndef HIST_SUB_BITS
+  #define HIST_SUB_BITS 3
+#endif
+
+/**
+ * @brief the values not less than 1 << HIST_MAX_BITS fall into the last bucket
+ */
+#ifndef HIST_MAX_BITS
+  #define HIST_MAX_BITS 40
+#endif
+
+#define HIST_SUB_COUNT (1 << HIST_SUB_BITS)
+#define HIST_BUCKETS ((HIST_MAX_BITS - HIST_SUB_BITS + 1) * HIST_SUB_COUNT)
+
+typedef struct _hist_ctx_t {
+  uint64_t count;
+  uint64_t max;
+  uint32_t buckets[HIST_BUCKETS];
+} hist_ctx_t;
+
+/**
+ * @brief create a log-bucketed histogram. the values below HIST_SUB_COUNT have
+ * their own buckets, every power of two above is split into HIST_SUB_COUNT buckets
+ *
+ * @param ctx return histogram context if success
+ * @return frost_errcode_t
+ */
+frost_errcode_t hist_create(hist_ctx_t** ctx);
+
+/**
+ * @brief record a value
+ *
+ * @param ctx histogram context pointer
+ * @param value the value
+ * @return frost_errcode_t
+ */
+frost_errcode_t hist_record(hist_ctx_t* ctx, uint64_t value);
+
+/**
+ * @brief get the value at a quantile, it is the highest value equivalent to
+ * its bucket, and never larger than the max recorded
+ *
+ * @param ctx histogram context pointer
+ * @param ppm the quantile in ppm, 500000 for the median
+ * @param value return the value
+ * @return frost_errcode_t if nothing is recorded return frost_err_eof
+ */
+frost_errcode_t hist_quantile(hist_ctx_t* ctx, uint32_t ppm, uint64_t* value);
+
+/**
+ * @brief clear the recorded values
+ *
+ * @param ctx histogram context pointer
+ * @return frost_errcode_t
+ */
+frost_errcode_t hist_reset(hist_ctx_t* ctx);
+
+/**
+ * @brief destroy histogram
+ *
+ * @param ctx histogram context pointer
+ * @return frost_errcode_t
+ */
+frost_errcode_t hist_destroy(hist_ctx_t* ctx);
+
+#endif /* _FROST_DATA_HIST_H */
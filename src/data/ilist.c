@@ -0,0 +1,95 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#include <string.h>
+
+#include "../common.h"
+#include "ilist.h"
+
+/**
+ * MARK: ilist_init
+ * @brief initialize an intrusive list
+ *
+ * @param ctx list context pointer
+ */
+frost_errcode_t ilist_init(ilist_ctx_t* ctx) {
+
+  if(ctx == NULL)
+    return frost_err_invalid_parameter;
+
+  memset(ctx, 0, sizeof(ilist_ctx_t));
+  return frost_err_ok;
+}
+
+/**
+ * MARK: ilist_put
+ * @brief put node at the tail of list
+ *
+ * @param ctx list context pointer
+ * @param node node pointer
+ */
+frost_errcode_t ilist_put(ilist_ctx_t* ctx, ilist_node_t* node) {
+
+  if(ctx == NULL || node == NULL || node->list != NULL)
+    return frost_err_invalid_parameter;
+
+  node->next = NULL;
+  node->prev = ctx->tail;
+  node->list = ctx;
+
+  if(ctx->tail != NULL)
+    ctx->tail->next = node;
+  else
+    ctx->head = node;
+
+  ctx->tail = node;
+  ++ctx->size;
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: ilist_delete
+ * @brief delete node from list
+ *
+ * @param ctx list context pointer
+ * @param node node pointer
+ */
+frost_errcode_t ilist_delete(ilist_ctx_t* ctx, ilist_node_t* node) {
+
+  if(ctx == NULL || node == NULL || node->list != ctx)
+    return frost_err_invalid_parameter;
+
+  if(node->prev != NULL)
+    node->prev->next = node->next;
+  else
+    ctx->head = node->next;
+
+  if(node->next != NULL)
+    node->next->prev = node->prev;
+  else
+    ctx->tail = node->prev;
+
+  node->next = NULL;
+  node->prev = NULL;
+  node->list = NULL;
+  --ctx->size;
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: ilist_is_linked
+ * @brief is node linked in a list
+ *
+ * @param node node pointer
+ */
+bool ilist_is_linked(ilist_node_t* node) {
+  return node != NULL && node->list != NULL;
+}
@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#ifndef _FROST_DATA_ILIST_H
+#define _FROST_DATA_ILIST_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "../common.h"
+
+typedef struct _ilist_node_t {
+  struct _ilist_node_t* next;
+  struct _ilist_node_t* prev;
+  struct _ilist_ctx_t* list; /* the list holds this node, NULL if not linked */
+} ilist_node_t;
+
+typedef struct _ilist_ctx_t {
+  ilist_node_t* head;
+  ilist_node_t* tail;
+  size_t size;
+} ilist_ctx_t;
+
+/**
+ * @brief get the object embeds the node
+ *
+ * @param node node pointer
+ * @param type type of the object
+ * @param member the node member of the object
+ */
+#define ilist_entry(node, type, member) \
+  ((type *)((uint8_t *)(node) - offsetof(type, member)))
+
+/**
+ * @brief initialize an intrusive list. the nodes are embedded in the objects,
+ * the list allocates nothing. a node can be linked in one list at a time
+ *
+ * @param ctx list context pointer
+ * @return frost_errcode_t
+ */
+frost_errcode_t ilist_init(ilist_ctx_t* ctx);
+
+/**
+ * @brief put node at the tail of list. O(1)
+ *
+ * @param ctx list context pointer
+ * @param node node pointer, the node must not be linked
+ * @return frost_errcode_t
+ */
+frost_errcode_t ilist_put(ilist_ctx_t* ctx, ilist_node_t* node);
+
+/**
+ * @brief delete node from list. O(1)
+ *
+ * @param ctx list context pointer
+ * @param node node pointer
+ * @return frost_errcode_t if node is not linked in this list return frost_err_invalid_parameter
+ */
+frost_errcode_t ilist_delete(ilist_ctx_t* ctx, ilist_node_t* node);
+
+/**
+ * @brief is node linked in a list
+ *
+ * @param node node pointer
+ * @return linked return true
+ */
+bool ilist_is_linked(ilist_node_t* node);
+
+#endif /* _FROST_DATA_ILIST_H */
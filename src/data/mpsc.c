@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "../common.h"
+#include "../log.h"
+#include "mpsc.h"
+
+#ifdef FROST_HAS_ATOMICS
+
+/**
+ * MARK: __mpsc_link
+ * @brief link the node at the head. the queue is broken between the exchange
+ * and the store until the producer finishes
+ */
+static void __mpsc_link(mpsc_ctx_t* ctx, mpsc_node_t* node) {
+  atomic_store_explicit(&node->next, NULL, memory_order_relaxed);
+  mpsc_node_t* _prev = atomic_exchange_explicit(&ctx->head, node, memory_order_acq_rel);
+  atomic_store_explicit(&_prev->next, node, memory_order_release);
+}
+
+/**
+ * MARK: mpsc_create
+ * @brief create a new mpsc queue
+ *
+ * @param ctx return queue context if success
+ */
+frost_errcode_t mpsc_create(mpsc_ctx_t** ctx) {
+
+  if(ctx == NULL)
+    return frost_err_invalid_parameter;
+
+  mpsc_ctx_t* _ctx = malloc(sizeof(mpsc_ctx_t)); {
+    if(_ctx == NULL)
+      return frost_err_out_of_memory;
+
+    memset(_ctx, 0, sizeof(mpsc_ctx_t));
+    atomic_init(&_ctx->stub.next, NULL);
+    atomic_init(&_ctx->head, &_ctx->stub);
+    _ctx->tail = &_ctx->stub;
+  }
+
+  *ctx = _ctx;
+  frost_log(TAG, "mpsc queue created %p", _ctx);
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: mpsc_push
+ * @brief push a node
+ *
+ * @param ctx queue context pointer
+ * @param node queue node
+ * @param data user data of the node
+ */
+frost_errcode_t mpsc_push(mpsc_ctx_t* ctx, mpsc_node_t* node, void* data) {
+
+  if(ctx == NULL || node == NULL)
+    return frost_err_invalid_parameter;
+
+  node->data = data;
+  __mpsc_link(ctx, node);
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: mpsc_pop
+ * @brief pop a node
+ *
+ * @param ctx queue context pointer
+ * @param node return the node
+ */
+frost_errcode_t mpsc_pop(mpsc_ctx_t* ctx, mpsc_node_t** node) {
+
+  if(ctx == NULL || node == NULL)
+    return frost_err_invalid_parameter;
+
+  mpsc_node_t* _tail = ctx->tail;
+  mpsc_node_t* _next = atomic_load_explicit(&_tail->next, memory_order_acquire);
+
+  // skip the stub
+  if(_tail == &ctx->stub) {
+    if(_next == NULL)
+      return frost_err_eof;
+
+    ctx->tail = _next;
+    _tail = _next;
+    _next = atomic_load_explicit(&_next->next, memory_order_acquire);
+  }
+
+  if(_next != NULL) {
+    ctx->tail = _next;
+    *node = _tail;
+    return frost_err_ok;
+  }
+
+  // a producer is linking after the tail, try next time
+  if(_tail != atomic_load_explicit(&ctx->head, memory_order_acquire))
+    return frost_err_eof;
+
+  // the last node, put the stub behind it to detach it
+  __mpsc_link(ctx, &ctx->stub);
+
+  _next = atomic_load_explicit(&_tail->next, memory_order_acquire);
+  if(_next == NULL)
+    return frost_err_eof;
+
+  ctx->tail = _next;
+  *node = _tail;
+  return frost_err_ok;
+}
+
+/**
+ * MARK: mpsc_is_empty
+ * @brief is the queue empty
+ *
+ * @param ctx queue context pointer
+ */
+bool mpsc_is_empty(mpsc_ctx_t* ctx) {
+
+  if(ctx == NULL)
+    return true;
+
+  // only the stub is left, and nobody is pushing
+  return ctx->tail == &ctx->stub &&
+         atomic_load_explicit(&ctx->head, memory_order_seq_cst) == &ctx->stub;
+}
+
+/**
+ * MARK: mpsc_destroy
+ * @brief destroy queue
+ *
+ * @param ctx queue context pointer
+ */
+frost_errcode_t mpsc_destroy(mpsc_ctx_t* ctx) {
+
+  if(ctx == NULL)
+    return frost_err_invalid_parameter;
+
+  frost_log(TAG, "mpsc queue destroyed %p", ctx);
+  free(ctx);
+
+  return frost_err_ok;
+}
+
+#endif /* FROST_HAS_ATOMICS */
@@ -0,0 +1,80 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#ifndef _FROST_DATA_MPSC_H
+#define _FROST_DATA_MPSC_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "../common.h"
+
+#ifdef FROST_HAS_ATOMICS
+
+#include <stdatomic.h>
+
+typedef struct _mpsc_node_t {
+  _Atomic(struct _mpsc_node_t*) next;
+  void* data;
+} mpsc_node_t;
+
+typedef struct _mpsc_ctx_t {
+  _Atomic(mpsc_node_t*) head; /* producers push here */
+  char __pad0[FROST_CACHE_LINE - sizeof(void*)];
+  mpsc_node_t* tail; /* consumer pops here */
+  mpsc_node_t stub;
+} mpsc_ctx_t;
+
+/**
+ * @brief create a new intrusive multi-producer single-consumer queue (Vyukov)
+ *
+ * @param ctx return queue context if success
+ * @return frost_errcode_t
+ */
+frost_errcode_t mpsc_create(mpsc_ctx_t** ctx);
+
+/**
+ * @brief push a node, safe to call from any thread. wait-free
+ *
+ * @param ctx queue context pointer
+ * @param node queue node, the node must not in any queue
+ * @param data user data of the node
+ * @return frost_errcode_t
+ */
+frost_errcode_t mpsc_push(mpsc_ctx_t* ctx, mpsc_node_t* node, void* data);
+
+/**
+ * @brief pop a node, consumer only. a node being pushed is not visible until the push completes
+ *
+ * @param ctx queue context pointer
+ * @param node return the node
+ * @return frost_errcode_t if nothing can be popped return frost_err_eof
+ */
+frost_errcode_t mpsc_pop(mpsc_ctx_t* ctx, mpsc_node_t** node);
+
+/**
+ * @brief is the queue empty, consumer only. a node being pushed is treated as not empty
+ *
+ * @param ctx queue context pointer
+ * @return bool
+ */
+bool mpsc_is_empty(mpsc_ctx_t* ctx);
+
+/**
+ * @brief destroy queue, the remaining nodes are owned by the caller and will not be touched
+ *
+ * @param ctx queue context pointer
+ * @return frost_errcode_t
+ */
+frost_errcode_t mpsc_destroy(mpsc_ctx_t* ctx);
+
+#endif /* FROST_HAS_ATOMICS */
+
+#endif /* _FROST_DATA_MPSC_H */
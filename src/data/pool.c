@@ -0,0 +1,274 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "../common.h"
+#include "../log.h"
+#include "pool.h"
+
+// keep the payload 16 bytes aligned
+#define __POOL_HEADER ((sizeof(pool_block_t) + 15) & ~(size_t)15)
+#define __POOL_OVERSIZE UINT32_MAX
+
+/**
+ * MARK: __pool_shift
+ * @brief get the shift of the smallest power of two not less than size
+ */
+static size_t __pool_shift(size_t size) {
+  size_t _shift = 0;
+  while(((size_t)1 << _shift) < size) ++_shift;
+  return _shift;
+}
+
+/**
+ * MARK: __pool_cache
+ * @brief cache a free block of the class, or give it back to the system if the class is full
+ *
+ * @param ctx pool context pointer
+ * @param index size class
+ * @param block the block
+ */
+static void __pool_cache(pool_ctx_t* ctx, uint32_t index, pool_block_t* block) {
+
+  if(ctx->free[index].count >= ctx->cap) {
+    free(block);
+    return;
+  }
+
+  pool_free_t* _free = (pool_free_t *)((uint8_t *)block + __POOL_HEADER);
+  _free->next = ctx->free[index].head;
+  ctx->free[index].head = _free;
+  ++ctx->free[index].count;
+}
+
+/**
+ * MARK: __pool_reclaim
+ * @brief take back the blocks of the class freed by the other threads
+ *
+ * @param ctx pool context pointer
+ * @param index size class
+ */
+static void __pool_reclaim(pool_ctx_t* ctx, uint32_t index) {
+
+  #ifdef FROST_HAS_ATOMICS
+  if(atomic_load_explicit(&ctx->remote[index], memory_order_relaxed) == NULL)
+    return;
+
+  pool_free_t* _free = atomic_exchange_explicit(&ctx->remote[index], NULL, memory_order_acquire);
+  while(_free != NULL) {
+    pool_free_t* _next = _free->next;
+    __pool_cache(ctx, index, (pool_block_t *)((uint8_t *)_free - __POOL_HEADER));
+    _free = _next;
+  }
+  #else
+  (void)ctx; (void)index;
+  #endif
+}
+
+/**
+ * MARK: pool_create
+ * @brief create a size-class block allocator
+ *
+ * @param min_size size of the smallest class
+ * @param max_size size of the biggest class
+ * @param cap max cached blocks per class
+ * @param ctx return pool context if success
+ */
+frost_errcode_t pool_create(size_t min_size, size_t max_size, size_t cap, pool_ctx_t** ctx) {
+
+  if(ctx == NULL || max_size < min_size)
+    return frost_err_invalid_parameter;
+
+  // the smallest class holds the header and the freelist link
+  if(min_size < __POOL_HEADER + sizeof(pool_free_t))
+    min_size = __POOL_HEADER + sizeof(pool_free_t);
+
+  size_t _min_shift = __pool_shift(min_size);
+  size_t _max_shift = __pool_shift(max_size);
+  if(_max_shift < _min_shift) _max_shift = _min_shift;
+  if(_max_shift - _min_shift >= POOL_MAX_CLASSES)
+    return frost_err_invalid_parameter;
+
+  pool_ctx_t* _ctx = malloc(sizeof(pool_ctx_t)); {
+    if(_ctx == NULL)
+      return frost_err_out_of_memory;
+
+    memset(_ctx, 0, sizeof(pool_ctx_t));
+    _ctx->min_shift = _min_shift;
+    _ctx->classes = _max_shift - _min_shift + 1;
+    _ctx->cap = cap;
+
+    #ifdef FROST_HAS_ATOMICS
+    for(size_t i = 0; i < POOL_MAX_CLASSES; ++i) {
+      atomic_init(&_ctx->remote[i], NULL);
+    }
+    #endif
+  }
+
+  *ctx = _ctx;
+  frost_log(TAG, "pool created %p, %zu classes from %zu bytes", _ctx, _ctx->classes, (size_t)1 << _min_shift);
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: pool_alloc
+ * @brief allocate a block
+ *
+ * @param ctx pool context pointer, NULL to allocate by malloc
+ * @param size block size
+ * @param ptr return the block
+ */
+frost_errcode_t pool_alloc(pool_ctx_t* ctx, size_t size, void** ptr) {
+
+  if(ptr == NULL || size > SIZE_MAX - __POOL_HEADER)
+    return frost_err_invalid_parameter;
+
+  size_t _length = __POOL_HEADER + size;
+  pool_block_t* _block = NULL;
+
+  // no pool, or larger than the biggest class
+  if(ctx == NULL || _length > ((size_t)1 << (ctx->min_shift + ctx->classes - 1))) {
+    if((_block = malloc(_length)) == NULL)
+      return frost_err_out_of_memory;
+
+    _block->pool = NULL;
+    _block->index = __POOL_OVERSIZE;
+
+    if(ctx != NULL) {
+      ++ctx->stats.miss;
+      ++ctx->stats.oversize;
+    }
+
+    *ptr = (uint8_t *)_block + __POOL_HEADER;
+    return frost_err_ok;
+  }
+
+  size_t _shift = __pool_shift(_length);
+  uint32_t _index = _shift > ctx->min_shift ? (uint32_t)(_shift - ctx->min_shift) : 0;
+
+  if(ctx->free[_index].head == NULL)
+    __pool_reclaim(ctx, _index);
+
+  // take a cached block, or a new one from the system
+  pool_free_t* _free = ctx->free[_index].head;
+  if(_free != NULL) {
+    ctx->free[_index].head = _free->next;
+    --ctx->free[_index].count;
+    _block = (pool_block_t *)((uint8_t *)_free - __POOL_HEADER);
+    ++ctx->stats.hit;
+  }
+  else {
+    if((_block = malloc((size_t)1 << (ctx->min_shift + _index))) == NULL)
+      return frost_err_out_of_memory;
+
+    _block->pool = ctx;
+    _block->index = _index;
+    ++ctx->stats.miss;
+  }
+
+  *ptr = (uint8_t *)_block + __POOL_HEADER;
+  return frost_err_ok;
+}
+
+/**
+ * MARK: pool_free
+ * @brief free a block on any thread
+ *
+ * @param ctx the pool owned by current thread, or NULL
+ * @param ptr the block
+ */
+frost_errcode_t pool_free(pool_ctx_t* ctx, void* ptr) {
+
+  if(ptr == NULL)
+    return frost_err_invalid_parameter;
+
+  pool_block_t* _block = (pool_block_t *)((uint8_t *)ptr - __POOL_HEADER);
+
+  if(_block->pool == NULL) {
+    free(_block);
+    return frost_err_ok;
+  }
+
+  // the owner caches it directly
+  if(_block->pool == ctx) {
+    __pool_cache(ctx, _block->index, _block);
+    return frost_err_ok;
+  }
+
+  // push only, the owner takes the whole stack at once so there's no ABA
+  #ifdef FROST_HAS_ATOMICS
+  _Atomic(pool_free_t*)* _remote = &_block->pool->remote[_block->index];
+  pool_free_t* _free = (pool_free_t *)ptr;
+  pool_free_t* _head = atomic_load_explicit(_remote, memory_order_relaxed);
+  do {
+    _free->next = _head;
+  } while(!atomic_compare_exchange_weak_explicit(_remote, &_head, _free,
+          memory_order_release, memory_order_relaxed));
+  #else
+  __pool_cache(_block->pool, _block->index, _block);
+  #endif
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: pool_get_stats
+ * @brief get pool statistics
+ *
+ * @param ctx pool context pointer
+ * @param stats return the statistics
+ */
+frost_errcode_t pool_get_stats(pool_ctx_t* ctx, pool_stats_t* stats) {
+
+  if(ctx == NULL || stats == NULL)
+    return frost_err_invalid_parameter;
+
+  *stats = ctx->stats;
+  stats->cached = 0;
+  for(size_t i = 0; i < ctx->classes; ++i) {
+    stats->cached += ctx->free[i].count;
+  }
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: pool_destroy
+ * @brief destroy pool
+ *
+ * @param ctx pool context pointer
+ */
+frost_errcode_t pool_destroy(pool_ctx_t* ctx) {
+
+  if(ctx == NULL)
+    return frost_err_invalid_parameter;
+
+  for(uint32_t i = 0; i < ctx->classes; ++i) {
+
+    // nothing is cached over the cap any more
+    ctx->cap = 0;
+    __pool_reclaim(ctx, i);
+
+    pool_free_t* _free = ctx->free[i].head;
+    while(_free != NULL) {
+      pool_free_t* _next = _free->next;
+      free((uint8_t *)_free - __POOL_HEADER);
+      _free = _next;
+    }
+  }
+
+  frost_log(TAG, "pool destroyed %p", ctx);
+  free(ctx);
+
+  return frost_err_ok;
+}
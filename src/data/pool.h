@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#ifndef _FROST_DATA_POOL_H
+#define _FROST_DATA_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "../common.h"
+
+#ifdef FROST_HAS_ATOMICS
+  #include <stdatomic.h>
+#endif
+
+#define POOL_MAX_CLASSES 16
+
+typedef struct _pool_block_t {
+  struct _pool_ctx_t* pool; /* the pool owns this block, NULL if allocated by malloc */
+  uint32_t index; /* size class */
+  uint32_t __reserved;
+} pool_block_t;
+
+typedef struct _pool_free_t {
+  struct _pool_free_t* next;
+} pool_free_t;
+
+typedef struct _pool_stats_t {
+  size_t hit; /* allocations served by the cached blocks */
+  size_t miss; /* allocations fell back to malloc, the oversized included */
+  size_t oversize; /* allocations larger than the biggest class */
+  size_t cached; /* blocks cached by the owner */
+} pool_stats_t;
+
+typedef struct _pool_ctx_t {
+  size_t min_shift; /* the smallest class is 1 << min_shift bytes */
+  size_t classes;
+  size_t cap; /* max cached blocks per class */
+  pool_stats_t stats;
+  struct {
+    pool_free_t* head; /* owner only */
+    size_t count;
+  } free[POOL_MAX_CLASSES];
+  #ifdef FROST_HAS_ATOMICS
+  char __pad0[FROST_CACHE_LINE];
+  _Atomic(pool_free_t*) remote[POOL_MAX_CLASSES]; /* freed by the other threads */
+  #endif
+} pool_ctx_t;
+
+/**
+ * @brief create a variable-size block allocator with power-of-two size classes.
+ * the freed blocks are cached by class up to the cap, the oversized blocks
+ * go to malloc directly. the owner thread allocates, any thread can free
+ *
+ * @param min_size size of the smallest class in bytes, header included. 0 for the smallest possible
+ * @param max_size size of the biggest class in bytes, header included
+ * @param cap max cached blocks per class
+ * @param ctx return pool context if success
+ * @return frost_errcode_t
+ */
+frost_errcode_t pool_create(size_t min_size, size_t max_size, size_t cap, pool_ctx_t** ctx);
+
+/**
+ * @brief allocate a block, owner only
+ *
+ * @param ctx pool context pointer, NULL to allocate by malloc
+ * @param size block size
+ * @param ptr return the block
+ * @return frost_errcode_t
+ */
+frost_errcode_t pool_alloc(pool_ctx_t* ctx, size_t size, void** ptr);
+
+/**
+ * @brief free a block on any thread. the block goes back to ctx directly if it
+ * comes from ctx, otherwise to its own pool by a lock-free push
+ *
+ * @param ctx the pool owned by current thread, or NULL
+ * @param ptr the block
+ * @return frost_errcode_t
+ */
+frost_errcode_t pool_free(pool_ctx_t* ctx, void* ptr);
+
+/**
+ * @brief get pool statistics, owner only
+ *
+ * @param ctx pool context pointer
+ * @param stats return the statistics
+ * @return frost_errcode_t
+ */
+frost_errcode_t pool_get_stats(pool_ctx_t* ctx, pool_stats_t* stats);
+
+/**
+ * @brief destroy pool and free the cached blocks, the blocks not freed become invalid
+ *
+ * @param ctx pool context pointer
+ * @return frost_errcode_t
+ */
+frost_errcode_t pool_destroy(pool_ctx_t* ctx);
+
+#endif /* _FROST_DATA_POOL_H */
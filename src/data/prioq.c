@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "../common.h"
+#include "../log.h"
+#include "prioq.h"
+
+/**
+ * MARK: __prioq_top
+ * @brief get the highest set bit of a non-zero bitmap
+ */
+static uint32_t __prioq_top(uint32_t bitmap) {
+  #ifdef __GNUC__
+  return 31 - (uint32_t)__builtin_clz(bitmap);
+  #else
+  uint32_t _n = 31;
+  while(!(bitmap & 0x80000000u)) { bitmap <<= 1; --_n; }
+  return _n;
+  #endif
+}
+
+/**
+ * MARK: prioq_create
+ * @brief create a multi-level priority queue
+ *
+ * @param ctx return queue context if success
+ */
+frost_errcode_t prioq_create(prioq_ctx_t** ctx) {
+
+  if(ctx == NULL)
+    return frost_err_invalid_parameter;
+
+  prioq_ctx_t* _ctx = malloc(sizeof(prioq_ctx_t)); {
+    if(_ctx == NULL)
+      return frost_err_out_of_memory;
+    memset(_ctx, 0, sizeof(prioq_ctx_t));
+  }
+
+  *ctx = _ctx;
+  frost_log(TAG, "priority queue created %p", _ctx);
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: prioq_push
+ * @brief push node into the level
+ *
+ * @param ctx queue context pointer
+ * @param node heap node
+ * @param level priority level
+ * @param key the key
+ */
+frost_errcode_t prioq_push(prioq_ctx_t* ctx, heap_node_t* node, uint32_t level, int64_t key) {
+
+  if(ctx == NULL || level >= PRIOQ_LEVELS)
+    return frost_err_invalid_parameter;
+
+  frost_errcode_t _result;
+
+  // the levels never used take no memory
+  if(ctx->levels[level] == NULL && !frost_ok(_result = heap_create(0, &ctx->levels[level])))
+    return _result;
+
+  if(!frost_ok(_result = heap_push(ctx->levels[level], node, key)))
+    return _result;
+
+  ctx->bitmap |= (uint32_t)1 << level;
+  ++ctx->size;
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: prioq_pop
+ * @brief pop the node of the highest level with smallest key
+ *
+ * @param ctx queue context pointer
+ * @param node return the node
+ */
+frost_errcode_t prioq_pop(prioq_ctx_t* ctx, heap_node_t** node) {
+
+  if(ctx == NULL || node == NULL)
+    return frost_err_invalid_parameter;
+
+  if(ctx->bitmap == 0) {
+    *node = NULL;
+    return frost_err_eof;
+  }
+
+  uint32_t _level = __prioq_top(ctx->bitmap);
+  heap_ctx_t* _heap = ctx->levels[_level];
+
+  heap_pop(_heap, node);
+  if(_heap->size == 0) ctx->bitmap &= ~((uint32_t)1 << _level);
+  --ctx->size;
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: prioq_delete
+ * @brief delete a node from the level
+ *
+ * @param ctx queue context pointer
+ * @param node heap node
+ * @param level the level of node
+ */
+frost_errcode_t prioq_delete(prioq_ctx_t* ctx, heap_node_t* node, uint32_t level) {
+
+  if(ctx == NULL || node == NULL || level >= PRIOQ_LEVELS)
+    return frost_err_invalid_parameter;
+
+  heap_ctx_t* _heap = ctx->levels[level];
+  if(_heap == NULL || !heap_is_queued(node))
+    return frost_err_ok;
+
+  heap_delete(_heap, node);
+  if(_heap->size == 0) ctx->bitmap &= ~((uint32_t)1 << level);
+  --ctx->size;
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: prioq_destroy
+ * @brief destroy queue
+ *
+ * @param ctx queue context pointer
+ */
+frost_errcode_t prioq_destroy(prioq_ctx_t* ctx) {
+
+  if(ctx == NULL)
+    return frost_err_invalid_parameter;
+
+  for(uint32_t i = 0; i < PRIOQ_LEVELS; ++i) {
+    if(ctx->levels[i] != NULL) heap_destroy(ctx->levels[i]);
+  }
+
+  frost_log(TAG, "priority queue destroyed %p", ctx);
+  free(ctx);
+
+  return frost_err_ok;
+}
@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#ifndef _FROST_DATA_PRIOQ_H
+#define _FROST_DATA_PRIOQ_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "../common.h"
+#include "heap.h"
+
+/**
+ * @brief priority levels, the bitmap of non-empty levels is 32 bits
+ */
+#define PRIOQ_LEVELS 32
+
+typedef struct _prioq_ctx_t {
+  heap_ctx_t* levels[PRIOQ_LEVELS]; /* min-heap per level, created on demand */
+  uint32_t bitmap; /* bit n is set if level n is not empty */
+  size_t size;
+} prioq_ctx_t;
+
+/**
+ * @brief create a multi-level priority queue. the node of the highest
+ * non-empty level pops first, the smallest key breaks the ties in a level
+ *
+ * @param ctx return queue context if success
+ * @return frost_errcode_t
+ */
+frost_errcode_t prioq_create(prioq_ctx_t** ctx);
+
+/**
+ * @brief push node into the level. O(log n) in the level
+ *
+ * @param ctx queue context pointer
+ * @param node heap node, the node must not in any heap
+ * @param level priority level, 0 to PRIOQ_LEVELS - 1, the higher pops first
+ * @param key the key, smaller key pops first in the level
+ * @return frost_errcode_t
+ */
+frost_errcode_t prioq_push(prioq_ctx_t* ctx, heap_node_t* node, uint32_t level, int64_t key);
+
+/**
+ * @brief pop the node of the highest level with smallest key.
+ * the level is found by count leading zeros of the bitmap, O(1)
+ *
+ * @param ctx queue context pointer
+ * @param node return the node, NULL if queue is empty
+ * @return frost_errcode_t if queue is empty return frost_err_eof
+ */
+frost_errcode_t prioq_pop(prioq_ctx_t* ctx, heap_node_t** node);
+
+/**
+ * @brief delete a node from the level it was pushed. O(log n) in the level
+ *
+ * @param ctx queue context pointer
+ * @param node heap node
+ * @param level the level of node
+ * @return frost_errcode_t
+ */
+frost_errcode_t prioq_delete(prioq_ctx_t* ctx, heap_node_t* node, uint32_t level);
+
+/**
+ * @brief destroy queue, the nodes are owned by the caller and will not be touched
+ *
+ * @param ctx queue context pointer
+ * @return frost_errcode_t
+ */
+frost_errcode_t prioq_destroy(prioq_ctx_t* ctx);
+
+#endif /* _FROST_DATA_PRIOQ_H */
@@ -16,22 +16,60 @@
 #include "slab-rb.h"
 
 /**
- * MARK: __rbnode_needs_free
- * @brief conditicates the node is need to free
+ * MARK: __rb_pow2
+ * @brief round up to power of two
+ */
+static size_t __rb_pow2(size_t value) {
+  size_t _pow2 = 1;
+  while(_pow2 < value) _pow2 <<= 1;
+  return _pow2;
+}
+
+/**
+ * MARK: __rb_slot
+ * @brief get the slot of a counter
  *
- * @param rb ringbuffer header pointer
- * @param node the ringbuffer node
+ * @param rb ring buffer header pointer
+ * @param counter head or tail counter
  */
-static bool __rbnode_needs_free(rb_header_t* rb, rb_node_t* node) {
-  return (node < rb->init_rb_body) || (node > (rb->init_rb_body + rb->init_rb_body_size));
+static size_t* __rb_slot(rb_header_t* rb, size_t counter) {
+  return (size_t*)(rb->body + (counter & rb->mask) * rb->stride);
 }
 
 /**
- * MARK: __rbnode_data_area
- * @brief get rb node data area
+ * MARK: __rb_grow
+ * @brief double the capacity, the data is moved to the front of new body in order
+ *
+ * @param rb ring buffer header pointer
  */
-static void* __rbnode_data_area(rb_node_t* node) {
-  return (void*)(node + 1);
+static frost_errcode_t __rb_grow(rb_header_t* rb) {
+
+  size_t _capacity = rb->capacity << 1;
+  if(_capacity == 0 || _capacity > rb->max_capacity)
+    return frost_err_full;
+
+  uint8_t* _body = (uint8_t*)malloc(_capacity * rb->stride); {
+    if(!_body) return frost_err_out_of_memory;
+  }
+
+  // the two runs, before and after the wrap
+  size_t _size = rb->tail - rb->head;
+  size_t _first = rb->capacity - (rb->head & rb->mask);
+  if(_first > _size) _first = _size;
+
+  memcpy(_body, (uint8_t*)__rb_slot(rb, rb->head), _first * rb->stride);
+  memcpy(_body + _first * rb->stride, rb->body, (_size - _first) * rb->stride);
+
+  free(rb->body);
+  rb->body = _body;
+  rb->head = 0;
+  rb->tail = _size;
+  rb->capacity = _capacity;
+  rb->mask = _capacity - 1;
+
+  frost_log(TAG, "ring buffer %p grows to %zu slots", rb, _capacity);
+
+  return frost_err_ok;
 }
 
 /**
@@ -39,47 +77,43 @@ static void* __rbnode_data_area(rb_node_t* node) {
  * @brief create ring buffer
  *
  * @param capacity initialize size
- * @param blocksz block size every node
+ * @param max_capacity grow up to it, 0 for the fixed capacity
+ * @param blocksz block size every slot
  * @param rb ring buffer context
  */
-frost_errcode_t rb_create(size_t capacity, size_t blocksz, rb_header_t** rb) {
+frost_errcode_t rb_create(size_t capacity, size_t max_capacity, size_t blocksz, rb_header_t** rb) {
+
+  if(capacity == 0 || blocksz == 0) {
+    return frost_err_invalid_parameter;
+  }
 
   rb_header_t* _rb_header = (rb_header_t*)malloc(sizeof(rb_header_t)); {
     if(!_rb_header) return frost_err_out_of_memory;
+    memset(_rb_header, 0, sizeof(*_rb_header));
   }
 
-  size_t _rb_body_length = capacity * (sizeof(rb_node_t) + blocksz);
-  rb_node_t* _rb_body = (rb_node_t*)malloc(_rb_body_length); {
+  // the length leads the block, keep the slots aligned
+  size_t _stride = (sizeof(size_t) + blocksz + sizeof(size_t) - 1) & ~(sizeof(size_t) - 1);
+
+  capacity = __rb_pow2(capacity);
+  max_capacity = max_capacity > capacity ? __rb_pow2(max_capacity) : capacity;
+
+  uint8_t* _rb_body = (uint8_t*)malloc(capacity * _stride); {
     if(!_rb_body) {
       free(_rb_header);
       return frost_err_out_of_memory;
     }
   }
 
-  memset(_rb_header, 0, sizeof(*_rb_header));
-  memset(_rb_body, 0, _rb_body_length);
-
-  #define __rb_slab(body, index, block) \
-    ((rb_node_t*)(((uint8_t*)body) + (index) * (sizeof(rb_node_t)+block)))
-
-  // build rb chain
-  rb_node_t* _rb_node_start = __rb_slab(_rb_body, 0, blocksz);
-  rb_node_t* _rb_node_end = __rb_slab(_rb_body, capacity - 1, blocksz); {
-    _rb_node_end->next = _rb_node_start;
-    for(size_t i = 0; i < capacity - 1; ++i) {
-      rb_node_t* _rb_node = __rb_slab(_rb_body, i, blocksz);
-      _rb_node->next = __rb_slab(_rb_body, i + 1, blocksz);
-    }
-  }
-
   // build rb header
-  _rb_header->rb_start = _rb_node_start;
-  _rb_header->rb_end = _rb_node_start;
-  _rb_header->init_rb_body = _rb_body;
-  _rb_header->init_rb_body_size = capacity;
-  _rb_header->size = 0;
+  _rb_header->body = _rb_body;
+  _rb_header->head = 0;
+  _rb_header->tail = 0;
+  _rb_header->mask = capacity - 1;
   _rb_header->capacity = capacity;
+  _rb_header->max_capacity = max_capacity;
   _rb_header->block_size = blocksz;
+  _rb_header->stride = _stride;
 
   if(rb) {
     *rb = _rb_header;
@@ -99,30 +133,20 @@ frost_errcode_t rb_put(rb_header_t* rb, void* data, size_t length) {
     return frost_err_invalid_parameter;
   }
 
-  // rb not full case
-  if(rb->size < rb->capacity - 1) {
-
-    // allocate erase and write
-    void* _area = __rbnode_data_area(rb->rb_end); {
-      rb->rb_end->size = length;
-      memcpy(_area, data, length);
-    }
-
-    // update header
-    rb->rb_end = rb->rb_end->next;
-    rb->size++;
+  // rb is full, grow if allowed
+  if(rb->tail - rb->head == rb->capacity) {
+    frost_errcode_t _result;
+    if(!frost_ok(_result = __rb_grow(rb)))
+      return _result;
   }
 
-  // rb is full (not considering insert)
-  // todo: insert
-  else {
-
-    //size_t _rb_node_length = sizeof(rb_node_t) + rb->block_size;
-    //malloc(_rb_node_length);
-
-    return frost_err_full;
+  size_t* _slot = __rb_slot(rb, rb->tail); {
+    *_slot = length;
+    memcpy(_slot + 1, data, length);
   }
 
+  rb->tail++;
+
   return frost_err_ok;
 }
 
@@ -132,15 +156,17 @@ frost_errcode_t rb_read(rb_header_t* rb, void* data, size_t* length, size_t* rem
     return frost_err_invalid_parameter;
   }
 
+  size_t _size = rb->tail - rb->head;
+
   // get information
   if(!data) {
 
     if(length) {
-      *length = rb->rb_start->size;
+      *length = _size ? *__rb_slot(rb, rb->head) : 0;
     }
 
     if(remain) {
-      *remain = rb->size;
+      *remain = _size;
     }
 
     return frost_err_ok;
@@ -154,7 +180,7 @@ frost_errcode_t rb_read(rb_header_t* rb, void* data, size_t* length, size_t* rem
     }
 
     // rb is empty
-    if(rb->size <= 0) {
+    if(_size == 0) {
 
       if(remain) {
         *remain = 0;
@@ -164,18 +190,17 @@ frost_errcode_t rb_read(rb_header_t* rb, void* data, size_t* length, size_t* rem
     }
 
     // do read data
-    void* _ptr = __rbnode_data_area(rb->rb_start); {
-      memcpy(data, _ptr, *length);
-      *length = rb->rb_start->size;
+    size_t* _slot = __rb_slot(rb, rb->head); {
+      memcpy(data, _slot + 1, *length);
+      *length = *_slot;
     }
 
     // update header
-    rb->rb_start = rb->rb_start->next;
-    rb->size--;
+    rb->head++;
 
     // get remain
     if(remain) {
-      *remain = rb->size;
+      *remain = _size - 1;
     }
 
     return frost_err_ok;
@@ -184,15 +209,85 @@ frost_errcode_t rb_read(rb_header_t* rb, void* data, size_t* length, size_t* rem
   return frost_err_fatal_error;
 }
 
+frost_errcode_t rb_put_many(rb_header_t* rb, void* data, size_t length, size_t count, size_t* put) {
+
+  if(!rb || !data || count == 0) {
+    return frost_err_invalid_parameter;
+  }
+
+  // write out of the block size is not allowed
+  if(length > rb->block_size) {
+    return frost_err_invalid_parameter;
+  }
+
+  // make room for the whole batch, grow if allowed
+  while(rb->capacity - (rb->tail - rb->head) < count) {
+    if(!frost_ok(__rb_grow(rb))) break;
+  }
+
+  size_t _count = rb->capacity - (rb->tail - rb->head);
+  if(_count == 0) {
+    return frost_err_full;
+  }
+
+  if(_count > count) _count = count;
+
+  for(size_t i = 0; i < _count; ++i) {
+    size_t* _slot = __rb_slot(rb, rb->tail + i);
+    *_slot = length;
+    memcpy(_slot + 1, (uint8_t*)data + i * length, length);
+  }
+
+  rb->tail += _count;
+
+  if(put) {
+    *put = _count;
+  }
+
+  return frost_err_ok;
+}
+
+frost_errcode_t rb_read_many(rb_header_t* rb, void* data, size_t length, size_t max, size_t* count) {
+
+  if(!rb || !data || !count) {
+    return frost_err_invalid_parameter;
+  }
+
+  // read out of the block size is not allowed
+  if(length > rb->block_size) {
+    return frost_err_invalid_parameter;
+  }
+
+  size_t _count = rb->tail - rb->head;
+  if(_count > max) _count = max;
+
+  *count = _count;
+
+  // rb is empty
+  if(_count == 0) {
+    return frost_err_eof;
+  }
+
+  for(size_t i = 0; i < _count; ++i) {
+    memcpy((uint8_t*)data + i * length, __rb_slot(rb, rb->head + i) + 1, length);
+  }
+
+  rb->head += _count;
+
+  return frost_err_ok;
+}
+
+size_t rb_size(rb_header_t* rb) {
+  return rb ? rb->tail - rb->head : 0;
+}
+
 frost_errcode_t rb_destroy(rb_header_t* rb) {
 
   if(!rb) {
     return frost_err_invalid_parameter;
   }
 
-  rb->size = 0;
-  rb->capacity = 0;
-  free(rb->init_rb_body);
+  free(rb->body);
   free(rb);
 
   return frost_err_ok;
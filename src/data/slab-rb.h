@@ -11,35 +11,32 @@
 #define _FROST_DATA_SLAB_RB_H
 
 #include <stddef.h>
+#include <stdint.h>
 #include <stdbool.h>
 
-typedef struct _rb_node_t {
-  struct _rb_node_t* next;
-  size_t size;
-} rb_node_t;
-
 typedef struct _rb_header_t {
-  bool self_increase;
-  rb_node_t* rb_start;
-  rb_node_t* rb_end;
-  rb_node_t* init_rb_body;
-  size_t init_rb_body_size;
-  size_t size;
-  size_t capacity;
+  uint8_t* body; /* capacity slots, a slot is the data length followed by the block */
+  size_t head; /* read counter, the slot index is head & mask */
+  size_t tail; /* write counter */
+  size_t mask;
+  size_t capacity; /* power of two */
+  size_t max_capacity; /* grows by doubling up to it when full */
   size_t block_size;
+  size_t stride; /* slot size */
 } rb_header_t;
 
 /**
  * @brief create ring buffer
  *
- * @param capacity initialize size
- * @param blocksz block size every nodes
+ * @param capacity initialize size, rounded up to power of two
+ * @param max_capacity grow by doubling when full up to it, 0 for the fixed capacity
+ * @param blocksz block size every slots
  * @param rb ring buffer context
  */
-frost_errcode_t rb_create(size_t capacity, size_t blocksz, rb_header_t** rb);
+frost_errcode_t rb_create(size_t capacity, size_t max_capacity, size_t blocksz, rb_header_t** rb);
 
 /**
- * @brief ring buffer put data
+ * @brief ring buffer put data, returns frost_err_full if it's full and cannot grow
  *
  * @param rb ring buffer context
  * @param data data being put
@@ -51,12 +48,43 @@ frost_errcode_t rb_put(rb_header_t* rb, void* data, size_t length);
  * @brief ring buffer read data
  *
  * @param rb ring buffer context
- * @param data data being put
- * @param length data length
+ * @param data data being put, pass NULL to get the length of next data and the remain only
+ * @param length the buffer length, return data length
  * @param remain remain
  */
 frost_errcode_t rb_read(rb_header_t* rb, void* data, size_t* length, size_t* remain);
 
+/**
+ * @brief ring buffer put a batch of data, grows once for the whole batch if allowed.
+ * puts as many as it can hold, returns frost_err_full if nothing is put
+ *
+ * @param rb ring buffer context
+ * @param data the blocks being put, one after another
+ * @param length length of every block
+ * @param count block count
+ * @param put return the count put
+ */
+frost_errcode_t rb_put_many(rb_header_t* rb, void* data, size_t length, size_t count, size_t* put);
+
+/**
+ * @brief ring buffer read a batch of data, returns frost_err_eof if it's empty
+ *
+ * @param rb ring buffer context
+ * @param data the buffer holds max blocks, one after another
+ * @param length length of every block
+ * @param max max block count
+ * @param count return the count read
+ */
+frost_errcode_t rb_read_many(rb_header_t* rb, void* data, size_t length, size_t max, size_t* count);
+
+/**
+ * @brief get the data count
+ *
+ * @param rb ring buffer context
+ * @return size_t
+ */
+size_t rb_size(rb_header_t* rb);
+
 /**
  * @brief clear ring buffer and destroy
  *
@@ -0,0 +1,184 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "../common.h"
+#include "../log.h"
+#include "slab.h"
+
+#define __SLAB_ALIGN 16
+
+/**
+ * MARK: __slab_grow
+ * @brief add a chunk and put its objects into the freelist
+ *
+ * @param ctx slab context pointer
+ */
+static frost_errcode_t __slab_grow(slab_ctx_t* ctx) {
+
+  size_t _header = (sizeof(slab_chunk_t) + __SLAB_ALIGN - 1) & ~(size_t)(__SLAB_ALIGN - 1);
+  slab_chunk_t* _chunk = malloc(_header + ctx->size * ctx->per_chunk); {
+    if(_chunk == NULL)
+      return frost_err_out_of_memory;
+
+    _chunk->next = ctx->chunks;
+    ctx->chunks = _chunk;
+  }
+
+  // link the objects in address order
+  uint8_t* _base = (uint8_t *)_chunk + _header;
+  for(size_t i = ctx->per_chunk; i > 0; --i) {
+    slab_block_t* _block = (slab_block_t *)(_base + (i - 1) * ctx->size);
+    _block->next = ctx->free;
+    ctx->free = _block;
+  }
+
+  ctx->capacity += ctx->per_chunk;
+  frost_log(TAG, "slab %p grows to %zu objects", ctx, ctx->capacity);
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: slab_create
+ * @brief create a fixed-size object allocator
+ *
+ * @param size object size
+ * @param per_chunk objects per chunk
+ * @param ctx return slab context if success
+ */
+frost_errcode_t slab_create(size_t size, size_t per_chunk, slab_ctx_t** ctx) {
+
+  if(ctx == NULL || size == 0 || per_chunk == 0)
+    return frost_err_invalid_parameter;
+
+  slab_ctx_t* _ctx = malloc(sizeof(slab_ctx_t)); {
+    if(_ctx == NULL)
+      return frost_err_out_of_memory;
+
+    memset(_ctx, 0, sizeof(slab_ctx_t));
+    _ctx->per_chunk = per_chunk;
+
+    // the freed object holds the freelist link
+    if(size < sizeof(slab_block_t)) size = sizeof(slab_block_t);
+    _ctx->size = (size + __SLAB_ALIGN - 1) & ~(size_t)(__SLAB_ALIGN - 1);
+
+    #ifdef FROST_HAS_ATOMICS
+    atomic_init(&_ctx->remote, NULL);
+    #endif
+  }
+
+  *ctx = _ctx;
+  frost_log(TAG, "slab created %p, object size %zu", _ctx, _ctx->size);
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: slab_alloc
+ * @brief allocate an object
+ *
+ * @param ctx slab context pointer
+ * @param ptr return the object
+ */
+frost_errcode_t slab_alloc(slab_ctx_t* ctx, void** ptr) {
+
+  if(ctx == NULL || ptr == NULL)
+    return frost_err_invalid_parameter;
+
+  frost_errcode_t _result;
+
+  // take back the objects freed by the other threads
+  #ifdef FROST_HAS_ATOMICS
+  if(ctx->free == NULL && atomic_load_explicit(&ctx->remote, memory_order_relaxed) != NULL) {
+    ctx->free = atomic_exchange_explicit(&ctx->remote, NULL, memory_order_acquire);
+  }
+  #endif
+
+  if(ctx->free == NULL && !frost_ok(_result = __slab_grow(ctx)))
+    return _result;
+
+  slab_block_t* _block = ctx->free;
+  ctx->free = _block->next;
+
+  *ptr = _block;
+  return frost_err_ok;
+}
+
+/**
+ * MARK: slab_free
+ * @brief free an object
+ *
+ * @param ctx slab context pointer
+ * @param ptr the object
+ */
+frost_errcode_t slab_free(slab_ctx_t* ctx, void* ptr) {
+
+  if(ctx == NULL || ptr == NULL)
+    return frost_err_invalid_parameter;
+
+  slab_block_t* _block = (slab_block_t *)ptr;
+  _block->next = ctx->free;
+  ctx->free = _block;
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: slab_free_remote
+ * @brief free an object from any thread
+ *
+ * @param ctx slab context pointer
+ * @param ptr the object
+ */
+frost_errcode_t slab_free_remote(slab_ctx_t* ctx, void* ptr) {
+
+  #ifdef FROST_HAS_ATOMICS
+  if(ctx == NULL || ptr == NULL)
+    return frost_err_invalid_parameter;
+
+  // push only, the owner takes the whole stack at once so there's no ABA
+  slab_block_t* _block = (slab_block_t *)ptr;
+  slab_block_t* _head = atomic_load_explicit(&ctx->remote, memory_order_relaxed);
+  do {
+    _block->next = _head;
+  } while(!atomic_compare_exchange_weak_explicit(&ctx->remote, &_head, _block,
+          memory_order_release, memory_order_relaxed));
+
+  return frost_err_ok;
+  #else
+  return slab_free(ctx, ptr);
+  #endif
+}
+
+/**
+ * MARK: slab_destroy
+ * @brief destroy slab
+ *
+ * @param ctx slab context pointer
+ */
+frost_errcode_t slab_destroy(slab_ctx_t* ctx) {
+
+  if(ctx == NULL)
+    return frost_err_invalid_parameter;
+
+  while(ctx->chunks != NULL) {
+    slab_chunk_t* _next = ctx->chunks->next;
+    free(ctx->chunks);
+    ctx->chunks = _next;
+  }
+
+  frost_log(TAG, "slab destroyed %p", ctx);
+  free(ctx);
+
+  return frost_err_ok;
+}
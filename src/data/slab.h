@@ -0,0 +1,91 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#ifndef _FROST_DATA_SLAB_H
+#define _FROST_DATA_SLAB_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "../common.h"
+
+#ifdef FROST_HAS_ATOMICS
+  #include <stdatomic.h>
+#endif
+
+typedef struct _slab_block_t {
+  struct _slab_block_t* next;
+} slab_block_t;
+
+typedef struct _slab_chunk_t {
+  struct _slab_chunk_t* next;
+} slab_chunk_t;
+
+typedef struct _slab_ctx_t {
+  slab_block_t* free; /* owner only */
+  slab_chunk_t* chunks;
+  size_t size; /* object size */
+  size_t per_chunk; /* objects per chunk */
+  size_t capacity; /* objects of all chunks */
+  #ifdef FROST_HAS_ATOMICS
+  char __pad0[FROST_CACHE_LINE];
+  _Atomic(slab_block_t*) remote; /* freed by the other threads, taken back by the owner in batch */
+  char __pad1[FROST_CACHE_LINE - sizeof(void*)];
+  #endif
+} slab_ctx_t;
+
+/**
+ * @brief create a fixed-size object allocator, the objects are carved from chunks
+ * and recycled by a freelist. the chunks are not returned to the system until destroy.
+ * the owner thread allocates and frees, the other threads can only free by @ref slab_free_remote()
+ *
+ * @param size object size
+ * @param per_chunk objects per chunk
+ * @param ctx return slab context if success
+ * @return frost_errcode_t
+ */
+frost_errcode_t slab_create(size_t size, size_t per_chunk, slab_ctx_t** ctx);
+
+/**
+ * @brief allocate an object, owner only. a new chunk is added if nothing is free
+ *
+ * @param ctx slab context pointer
+ * @param ptr return the object
+ * @return frost_errcode_t
+ */
+frost_errcode_t slab_alloc(slab_ctx_t* ctx, void** ptr);
+
+/**
+ * @brief free an object, owner only
+ *
+ * @param ctx slab context pointer
+ * @param ptr the object
+ * @return frost_errcode_t
+ */
+frost_errcode_t slab_free(slab_ctx_t* ctx, void* ptr);
+
+/**
+ * @brief free an object from any thread, lock-free
+ *
+ * @param ctx slab context pointer
+ * @param ptr the object
+ * @return frost_errcode_t
+ */
+frost_errcode_t slab_free_remote(slab_ctx_t* ctx, void* ptr);
+
+/**
+ * @brief destroy slab and free all chunks, the objects not freed become invalid
+ *
+ * @param ctx slab context pointer
+ * @return frost_errcode_t
+ */
+frost_errcode_t slab_destroy(slab_ctx_t* ctx);
+
+#endif /* _FROST_DATA_SLAB_H */
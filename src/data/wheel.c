@@ -0,0 +1,431 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "../common.h"
+#include "../log.h"
+#include "wheel.h"
+
+// the slot field of a node, zero means not pending,
+// so a zeroed node is a valid detached node
+#define WHEEL_SLOT_NONE    0
+#define WHEEL_SLOT_EXPIRED (FROST_WHEEL_LEVELS * WHEEL_SLOTS + 1)
+
+// the range of a level (in ticks)
+#define __wheel_range(level) (((uint64_t)1) << (FROST_WHEEL_BITS * ((level) + 1)))
+
+/**
+ * MARK: __wheel_ctz
+ * @brief count trailing zeros, the value must not be zero
+ */
+static int __wheel_ctz(uint64_t value) {
+  #ifdef __GNUC__
+  return __builtin_ctzll(value);
+  #else
+  int _n = 0;
+  while(!(value & 1)) { value >>= 1; ++_n; }
+  return _n;
+  #endif
+}
+
+/**
+ * MARK: __wheel_head
+ * @brief get the list head of a slot
+ */
+static wheel_node_t** __wheel_head(wheel_ctx_t* ctx, int32_t slot) {
+  if(slot == WHEEL_SLOT_EXPIRED) return &ctx->expired;
+  return &ctx->slots[slot - 1];
+}
+
+/**
+ * MARK: __wheel_link
+ * @brief link the node into slot
+ */
+static void __wheel_link(wheel_ctx_t* ctx, wheel_node_t* node, int32_t slot) {
+
+  wheel_node_t** _head = __wheel_head(ctx, slot); {
+    node->prev = NULL;
+    node->next = *_head;
+    if(*_head) (*_head)->prev = node;
+    *_head = node;
+  }
+
+  node->slot = slot;
+
+  // mark slot occupied
+  if(slot != WHEEL_SLOT_EXPIRED) {
+    ctx->bitmap[(slot - 1) / WHEEL_SLOTS] |= ((uint64_t)1) << ((slot - 1) & WHEEL_MASK);
+  }
+}
+
+/**
+ * MARK: __wheel_place
+ * @brief find a slot for the node relative to the reference tick.
+ * the slot of reference tick must not fired yet
+ *
+ * @param ctx wheel context pointer
+ * @param node timer node
+ * @param ref reference tick
+ */
+static void __wheel_place(wheel_ctx_t* ctx, wheel_node_t* node, uint64_t ref) {
+
+  uint64_t _expires = node->expires;
+
+  // already expired
+  if(_expires < ref) {
+    __wheel_link(ctx, node, WHEEL_SLOT_EXPIRED);
+    return;
+  }
+
+  // out of the wheel range, park it at the end of last level.
+  // it will be cascaded and placed again later
+  uint64_t _delta = _expires - ref;
+  if(_delta >= __wheel_range(FROST_WHEEL_LEVELS - 1)) {
+    _expires = ref + __wheel_range(FROST_WHEEL_LEVELS - 1) - 1;
+    _delta = _expires - ref;
+  }
+
+  // find the level
+  int _level = 0;
+  while(_delta >= __wheel_range(_level)) ++_level;
+
+  int32_t _index = (int32_t)((_expires >> (FROST_WHEEL_BITS * _level)) & WHEEL_MASK);
+  __wheel_link(ctx, node, _level * WHEEL_SLOTS + _index + 1);
+}
+
+/**
+ * MARK: __wheel_cascade
+ * @brief move the timers of upper level slot down to the lower levels
+ *
+ * @param ctx wheel context pointer
+ * @param level the level to cascade
+ * @param now current tick
+ */
+static void __wheel_cascade(wheel_ctx_t* ctx, int level, uint64_t now) {
+
+  if(level >= FROST_WHEEL_LEVELS)
+    return;
+
+  // cascade the upper level first when this level wraps
+  int32_t _index = (int32_t)((now >> (FROST_WHEEL_BITS * level)) & WHEEL_MASK);
+  if(_index == 0) __wheel_cascade(ctx, level + 1, now);
+
+  // detach the whole slot
+  int32_t _slot = level * WHEEL_SLOTS + _index + 1;
+  wheel_node_t* _node = *__wheel_head(ctx, _slot); {
+    *__wheel_head(ctx, _slot) = NULL;
+    ctx->bitmap[level] &= ~(((uint64_t)1) << _index);
+  }
+
+  // place them again
+  while(_node) {
+    wheel_node_t* _next = _node->next;
+    __wheel_place(ctx, _node, now);
+    _node = _next;
+  }
+}
+
+/**
+ * MARK: __wheel_fire
+ * @brief detach a slot and append its nodes to the expired chain
+ */
+static void __wheel_fire(wheel_ctx_t* ctx, int32_t slot, wheel_node_t** chain) {
+
+  wheel_node_t** _head = __wheel_head(ctx, slot);
+  wheel_node_t* _node = *_head;
+  *_head = NULL;
+
+  if(slot != WHEEL_SLOT_EXPIRED) {
+    ctx->bitmap[(slot - 1) / WHEEL_SLOTS] &= ~(((uint64_t)1) << ((slot - 1) & WHEEL_MASK));
+  }
+
+  while(_node) {
+    wheel_node_t* _next = _node->next; {
+      _node->slot = WHEEL_SLOT_NONE;
+      _node->prev = NULL;
+      _node->next = *chain;
+      *chain = _node;
+      --ctx->size;
+    }
+    _node = _next;
+  }
+}
+
+/**
+ * MARK: __wheel_skip
+ * @brief jump over the wrap points which cascade nothing, the first level must be empty.
+ * only the occupied bits of the upper levels are visited
+ *
+ * @param ctx wheel context pointer
+ * @param tick a wrap point of the first level
+ * @param limit the tick to stop
+ * @return uint64_t the next wrap point cascading something, or the one after limit
+ */
+static uint64_t __wheel_skip(wheel_ctx_t* ctx, uint64_t tick, uint64_t limit) {
+
+  #if FROST_WHEEL_LEVELS > 1
+  while(tick <= limit) {
+
+    // the slots cascaded at this tick, from the second level up to the one not wrapping
+    for(int _level = 1; _level < FROST_WHEEL_LEVELS; ++_level) {
+      int _index = (int)((tick >> (FROST_WHEEL_BITS * _level)) & WHEEL_MASK);
+      if(ctx->bitmap[_level] & (((uint64_t)1) << _index)) return tick;
+      if(_index != 0) break;
+    }
+
+    // the next occupied slot of the second level in this round, or its wrap point
+    int _index = (int)((tick >> FROST_WHEEL_BITS) & WHEEL_MASK);
+    uint64_t _bits = _index == WHEEL_MASK ? 0 : ctx->bitmap[1] & (~((uint64_t)0) << (_index + 1));
+    if(_bits == 0)
+      tick = ((tick >> (FROST_WHEEL_BITS * 2)) + 1) << (FROST_WHEEL_BITS * 2);
+    else
+      tick = ((tick >> (FROST_WHEEL_BITS * 2)) << (FROST_WHEEL_BITS * 2)) + ((uint64_t)__wheel_ctz(_bits) << FROST_WHEEL_BITS);
+  }
+  #else
+  (void)ctx; (void)limit;
+  #endif
+
+  return tick;
+}
+
+/**
+ * MARK: wheel_create
+ * @brief create a new timer wheel
+ *
+ * @param now current tick
+ * @param ctx return wheel context if success
+ */
+frost_errcode_t wheel_create(uint64_t now, wheel_ctx_t** ctx) {
+
+  if(ctx == NULL)
+    return frost_err_invalid_parameter;
+
+  wheel_ctx_t* _ctx = malloc(sizeof(wheel_ctx_t)); {
+    if(_ctx == NULL)
+      return frost_err_out_of_memory;
+
+    memset(_ctx, 0, sizeof(wheel_ctx_t));
+    _ctx->now = now;
+    *ctx = _ctx;
+  }
+
+  frost_log(TAG, "timer wheel created %p", _ctx);
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: wheel_add
+ * @brief add a timer node into wheel
+ *
+ * @param ctx wheel context pointer
+ * @param node timer node
+ * @param expires the tick when timer expires
+ */
+frost_errcode_t wheel_add(wheel_ctx_t* ctx, wheel_node_t* node, uint64_t expires) {
+
+  if(ctx == NULL || node == NULL)
+    return frost_err_invalid_parameter;
+
+  if(node->slot != WHEEL_SLOT_NONE)
+    return frost_err_invalid_parameter;
+
+  // the slot of `now` has been fired, start from the next tick
+  node->expires = expires;
+  __wheel_place(ctx, node, ctx->now + 1);
+  ++ctx->size;
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: wheel_delete
+ * @brief delete a pending timer node from wheel
+ *
+ * @param ctx wheel context pointer
+ * @param node timer node
+ */
+frost_errcode_t wheel_delete(wheel_ctx_t* ctx, wheel_node_t* node) {
+
+  if(ctx == NULL || node == NULL)
+    return frost_err_invalid_parameter;
+
+  if(node->slot == WHEEL_SLOT_NONE)
+    return frost_err_ok;
+
+  wheel_node_t** _head = __wheel_head(ctx, node->slot); {
+    if(node->prev) node->prev->next = node->next;
+    else *_head = node->next;
+    if(node->next) node->next->prev = node->prev;
+  }
+
+  // slot becomes empty
+  if(*_head == NULL && node->slot != WHEEL_SLOT_EXPIRED) {
+    ctx->bitmap[(node->slot - 1) / WHEEL_SLOTS] &= ~(((uint64_t)1) << ((node->slot - 1) & WHEEL_MASK));
+  }
+
+  node->slot = WHEEL_SLOT_NONE;
+  node->next = NULL;
+  node->prev = NULL;
+  --ctx->size;
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: wheel_advance
+ * @brief advance the wheel to the tick, and detach all expired timers
+ *
+ * @param ctx wheel context pointer
+ * @param now current tick
+ * @param expired return a chain of expired nodes
+ */
+frost_errcode_t wheel_advance(wheel_ctx_t* ctx, uint64_t now, wheel_node_t** expired) {
+
+  if(ctx == NULL || expired == NULL)
+    return frost_err_invalid_parameter;
+
+  wheel_node_t* _chain = NULL;
+
+  // timers were added with an expired tick
+  __wheel_fire(ctx, WHEEL_SLOT_EXPIRED, &_chain);
+
+  while(ctx->now < now) {
+
+    // nothing pending, jump to the tick directly
+    if(ctx->size == 0) {
+      ctx->now = now;
+      break;
+    }
+
+    // skip the empty slots of the first level,
+    // but always stop at the wrap point to cascade upper levels
+    uint64_t _tick = ctx->now + 1;
+    if((_tick & WHEEL_MASK) != 0) {
+      uint64_t _bits = ctx->bitmap[0] & (~((uint64_t)0) << (_tick & WHEEL_MASK));
+      if(_bits == 0) _tick = (_tick | WHEEL_MASK) + 1;
+      else _tick = (_tick & ~((uint64_t)WHEEL_MASK)) + __wheel_ctz(_bits);
+    }
+
+    // nothing in the first level, the wrap points cascading nothing are skipped too
+    if((_tick & WHEEL_MASK) == 0 && ctx->bitmap[0] == 0) {
+      _tick = __wheel_skip(ctx, _tick, now);
+    }
+
+    if(_tick > now) {
+      ctx->now = now;
+      break;
+    }
+
+    ctx->now = _tick;
+    if((_tick & WHEEL_MASK) == 0) {
+      __wheel_cascade(ctx, 1, _tick);
+    }
+
+    __wheel_fire(ctx, (int32_t)(_tick & WHEEL_MASK) + 1, &_chain);
+  }
+
+  *expired = _chain;
+  return frost_err_ok;
+}
+
+/**
+ * MARK: wheel_next_expiry
+ * @brief get the earliest expiry tick of all pending timers.
+ * slots of a level cover consecutive ranges starting from the slot next to
+ * current one, thus only the first occupied slot of every level is scanned.
+ * a timer parked out of the wheel range reports the tick its slot cascades
+ *
+ * @param ctx wheel context pointer
+ * @param expires return the earliest expiry tick
+ */
+frost_errcode_t wheel_next_expiry(wheel_ctx_t* ctx, uint64_t* expires) {
+
+  if(ctx == NULL || expires == NULL)
+    return frost_err_invalid_parameter;
+
+  if(ctx->size == 0)
+    return frost_err_eof;
+
+  // timers were added with an expired tick
+  if(ctx->expired != NULL) {
+    *expires = ctx->now;
+    return frost_err_ok;
+  }
+
+  bool _found = false;
+  uint64_t _min = UINT64_MAX;
+  uint64_t _mask = (WHEEL_SLOTS == 64) ? ~((uint64_t)0) : ((((uint64_t)1) << WHEEL_SLOTS) - 1);
+
+  for(int _level = 0; _level < FROST_WHEEL_LEVELS; ++_level) {
+
+    uint64_t _bits = ctx->bitmap[_level];
+    if(_bits == 0) continue;
+
+    // rotate the bitmap to start from the slot next to current one
+    int _start = (int)(((ctx->now >> (FROST_WHEEL_BITS * _level)) + 1) & WHEEL_MASK);
+    uint64_t _rotated = _bits >> _start;
+    if(_start != 0) _rotated |= (_bits << (WHEEL_SLOTS - _start)) & _mask;
+
+    int32_t _index = (_start + __wheel_ctz(_rotated)) & WHEEL_MASK;
+    wheel_node_t* _node = ctx->slots[_level * WHEEL_SLOTS + _index];
+
+    // the tick the slot cascades, the nodes parked out of the wheel range
+    // expire after their slot, they are due for placing again at this tick
+    uint64_t _width = ((uint64_t)1) << (FROST_WHEEL_BITS * _level);
+    uint64_t _cascade = ((ctx->now >> (FROST_WHEEL_BITS * (_level + 1))) << (FROST_WHEEL_BITS * (_level + 1))) +
+                        (uint64_t)_index * _width;
+    if(_cascade <= ctx->now) _cascade += __wheel_range(_level);
+
+    while(_node) {
+      uint64_t _expires = _node->expires;
+      if(_level == FROST_WHEEL_LEVELS - 1 && _expires >= _cascade + _width) _expires = _cascade;
+      if(_expires < _min) _min = _expires;
+      _node = _node->next;
+    }
+
+    _found = true;
+  }
+
+  if(!_found)
+    return frost_err_eof;
+
+  *expires = _min;
+  return frost_err_ok;
+}
+
+/**
+ * MARK: wheel_is_pending
+ * @brief is timer node pending in a wheel
+ *
+ * @param node timer node
+ */
+bool wheel_is_pending(wheel_node_t* node) {
+  return node != NULL && node->slot != WHEEL_SLOT_NONE;
+}
+
+/**
+ * MARK: wheel_destroy
+ * @brief destroy wheel
+ *
+ * @param ctx wheel context pointer
+ */
+frost_errcode_t wheel_destroy(wheel_ctx_t* ctx) {
+
+  if(ctx == NULL)
+    return frost_err_invalid_parameter;
+
+  frost_log(TAG, "timer wheel destroyed %p", ctx);
+  free(ctx);
+
+  return frost_err_ok;
+}
@@ -0,0 +1,118 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#ifndef _FROST_DATA_WHEEL_H
+#define _FROST_DATA_WHEEL_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/**
+ * @brief slot bits of every wheel level, a level has (1 << FROST_WHEEL_BITS) slots
+ */
+#ifndef FROST_WHEEL_BITS
+  #define FROST_WHEEL_BITS 6
+#endif
+
+/**
+ * @brief wheel levels, the wheel covers (1 << (FROST_WHEEL_BITS * FROST_WHEEL_LEVELS)) ticks,
+ * timers out of the range will be parked at the last level and re-cascaded
+ */
+#ifndef FROST_WHEEL_LEVELS
+  #define FROST_WHEEL_LEVELS 4
+#endif
+
+#if FROST_WHEEL_BITS > 6
+  #error "FROST_WHEEL_BITS must not greater than 6, the slot bitmap is 64 bits"
+#endif
+
+#define WHEEL_SLOTS (1 << FROST_WHEEL_BITS)
+#define WHEEL_MASK (WHEEL_SLOTS - 1)
+
+typedef struct _wheel_node_t {
+  struct _wheel_node_t* next;
+  struct _wheel_node_t* prev;
+  uint64_t expires;
+  int32_t slot;
+  void* data;
+} wheel_node_t;
+
+typedef struct _wheel_ctx_t {
+  uint64_t now;
+  size_t size;
+  uint64_t bitmap[FROST_WHEEL_LEVELS];
+  wheel_node_t* expired;
+  wheel_node_t* slots[FROST_WHEEL_LEVELS * WHEEL_SLOTS];
+} wheel_ctx_t;
+
+/**
+ * @brief create a new timer wheel
+ *
+ * @param now current tick, timers expire before it will fire at next advance
+ * @param ctx return wheel context if success
+ * @return frost_errcode_t
+ */
+frost_errcode_t wheel_create(uint64_t now, wheel_ctx_t** ctx);
+
+/**
+ * @brief add a timer node into wheel. O(1)
+ *
+ * @param ctx wheel context pointer
+ * @param node timer node, the node must not pending in any wheel
+ * @param expires the tick when timer expires
+ * @return frost_errcode_t
+ */
+frost_errcode_t wheel_add(wheel_ctx_t* ctx, wheel_node_t* node, uint64_t expires);
+
+/**
+ * @brief delete a pending timer node from wheel. O(1)
+ *
+ * @param ctx wheel context pointer
+ * @param node timer node
+ * @return frost_errcode_t
+ */
+frost_errcode_t wheel_delete(wheel_ctx_t* ctx, wheel_node_t* node);
+
+/**
+ * @brief advance the wheel to the tick, and detach all expired timers
+ *
+ * @param ctx wheel context pointer
+ * @param now current tick
+ * @param expired return a chain of expired nodes linked by `next`, NULL if nothing expired
+ * @return frost_errcode_t
+ */
+frost_errcode_t wheel_advance(wheel_ctx_t* ctx, uint64_t now, wheel_node_t** expired);
+
+/**
+ * @brief get the earliest expiry tick of all pending timers
+ *
+ * @param ctx wheel context pointer
+ * @param expires return the earliest expiry tick
+ * @return frost_errcode_t if nothing pending return frost_err_eof
+ */
+frost_errcode_t wheel_next_expiry(wheel_ctx_t* ctx, uint64_t* expires);
+
+/**
+ * @brief is timer node pending in a wheel
+ *
+ * @param node timer node
+ * @return pending return true
+ */
+bool wheel_is_pending(wheel_node_t* node);
+
+/**
+ * @brief destroy wheel, the pending nodes are owned by the caller and will not be touched
+ *
+ * @param ctx wheel context pointer
+ * @return frost_errcode_t
+ */
+frost_errcode_t wheel_destroy(wheel_ctx_t* ctx);
+
+#endif /* _FROST_DATA_WHEEL_H */
@@ -13,10 +13,24 @@
 #include "tls.h"
 #include "chan.h"
 #include "await.h"
+#include "executor.h"
+#include "coro.h"
 #include "callback.h"
 
 static frost_engine_t engine = { 0 };
 
+// the engine running a schedule pass on this thread
+static FROST_THREAD_LOCAL frost_engine_t* __current_engine = NULL;
+
+/**
+ * @brief get the engine running on this thread, or the default engine
+ *
+ * @return frost_engine_t*
+ */
+static frost_engine_t* __engine_current() {
+  return __current_engine ? __current_engine : &engine;
+}
+
 /**
  * @brief test frost task flag
  *
@@ -28,40 +42,610 @@ static int __fflag(frost_task_ctx_t* ctx, frost_flag_t flag) {
   return ctx->flags & flag;
 }
 
-frost_errcode_t frost_init() {
+/**
+ * @brief put task into a scheduler list
+ *
+ * @param ctx task ctx
+ * @param list the scheduler list
+ * @return frost_errcode_t if success return ok
+ */
+static frost_errcode_t __sched_queue(frost_task_ctx_t* ctx, ilist_ctx_t* list) {
+
+  frost_errcode_t _result;
+
+  if(!frost_ok(_result = ilist_put(list, &ctx->sched.link))) {
+    frost_log(TAG, "task '%s'[%p] cannot be queued, it will not be scheduled", ctx->name, ctx);
+    return _result;
+  }
+
+  return frost_err_ok;
+}
+
+/**
+ * @brief detach task from the scheduler lists and the timer wheel
+ *
+ * @param ctx task ctx
+ */
+static void __sched_unlink(frost_task_ctx_t* ctx) {
+
+  if(ilist_is_linked(&ctx->sched.link)) {
+    ilist_delete(ctx->sched.link.list, &ctx->sched.link);
+  }
+
+  if(wheel_is_pending(&ctx->sched.timer)) {
+    wheel_delete(ctx->engine->scheduler.timers, &ctx->sched.timer);
+  }
+
+  if(heap_is_queued(&ctx->sched.urgency)) {
+    prioq_delete(ctx->engine->scheduler.runq, &ctx->sched.urgency, ctx->priority);
+  }
+}
+
+/**
+ * @brief get the absolute deadline of a task, the task tick plus its relative
+ * deadline, or plus its interval if the deadline is not set
+ *
+ * @param ctx task ctx
+ * @return uint64_t the deadline tick
+ */
+static uint64_t __task_deadline(frost_task_ctx_t* ctx) {
+  return ctx->tick + (ctx->deadline ? ctx->deadline : ctx->interval);
+}
+
+/**
+ * @brief put task into run queue, the most urgent task of the highest priority runs first.
+ * the urgency is the absolute deadline, it keeps the order stable between passes
+ *
+ * @param ctx task ctx
+ * @return frost_errcode_t if success return ok
+ */
+static frost_errcode_t __sched_runq(frost_task_ctx_t* ctx) {
+
+  frost_errcode_t _result;
+
+  ctx->sched.urgency.data = ctx;
+
+  if(!frost_ok(_result = prioq_push(ctx->engine->scheduler.runq, &ctx->sched.urgency, ctx->priority, (int64_t)__task_deadline(ctx)))) {
+    frost_log(TAG, "task '%s'[%p] cannot be queued into run queue, retry in next pass", ctx->name, ctx);
+    return _result;
+  }
 
-  if(engine.initialized)
+  return frost_err_ok;
+}
+
+/**
+ * @brief file the task into the right place by its state.
+ *  - frozen task waiting for channel runs in next pass if it has unread packs,
+ *    otherwise it's parked until a channel write wakes it up
+ *  - frozen task is parked, only a flag change brings it back
+ *  - zero interval task runs in next pass
+ *  - interval task waits in the timer wheel until its tick
+ *  - suspended task waits until its resume tick, its release tick is kept
+ *
+ * @param ctx task ctx
+ * @return frost_errcode_t if success return ok
+ */
+static frost_errcode_t __sched_file(frost_task_ctx_t* ctx) {
+
+  // the scheduler files the running task after it returns
+  if(ctx->sched.running || ctx->sched.deleted)
+    return frost_err_ok;
+
+  __sched_unlink(ctx);
+
+  if(__fflag(ctx, frost_flag_freeze)) {
+    if(!__fflag(ctx, frost_flag_unfreeze_by_chan_write))
+      return frost_err_ok;
+
+    if(!ctx->chan.ref || ctx->chan.ref->notify_cnt <= 0)
+      return frost_err_ok;
+
+    // sync the tick to scheduler main tick to fire the task immediately
+    frost_trace(ctx->engine, frost_trace_task_unfreeze, ctx, ctx->chan.ref, 0);
+    ctx->tick = ctx->engine->scheduler.tick;
+    return __sched_queue(ctx, &ctx->engine->scheduler.ready);
+  }
+
+  // the suspended stackful or stackless task resumes at the tick it asked for,
+  // the tick stays the release of current run, its deadline and refill count from it
+  uint64_t _until = ctx->tick;
+  if(ctx->coro.ref != NULL || ctx->coro.line != 0) {
+    _until = ctx->coro.until;
+    if(_until <= ctx->engine->scheduler.tick)
+      return __sched_queue(ctx, &ctx->engine->scheduler.ready);
+  }
+
+  else if(ctx->interval == 0)
+    return __sched_queue(ctx, &ctx->engine->scheduler.ready);
+
+  ctx->sched.timer.data = ctx;
+  return wheel_add(ctx->engine->scheduler.timers, &ctx->sched.timer, _until);
+}
+
+/**
+ * @brief wake up the parked scheduler for a new task, the new task
+ * may have an earlier deadline than the scheduler is waiting for
+ *
+ * @param e engine
+ */
+static void __sched_wakeup(frost_engine_t* e) {
+  if(e->idle.ctx.parked) {
+    idle_wake(&e->idle.ctx);
+  }
+}
+
+#ifdef FROST_HAS_ATOMICS
+/**
+ * @brief post a task node to the inbox from any thread, and wake up the parked scheduler
+ *
+ * @param e engine
+ * @param node the submission or wake node of the task
+ * @param ctx task ctx
+ */
+static void __sched_post(frost_engine_t* e, mpsc_node_t* node, frost_task_ctx_t* ctx) {
+
+  mpsc_push(e->scheduler.inbox, node, ctx);
+
+  // pairs with the parking announcement of the scheduler
+  atomic_thread_fence(memory_order_seq_cst);
+  if(e->idle.ctx.parked) {
+    idle_wake(&e->idle.ctx);
+  }
+}
+#endif
+
+/**
+ * @brief idle until the next deadline, or the tick at most
+ *
+ * @param e engine
+ * @param until the tick to stop idling, or FROST_IDLE_INFINITE
+ */
+static void __sched_idle(frost_engine_t* e, uint64_t until) {
+
+  uint64_t _deadline = 0;
+  if(frost_ok(frost_get_next_deadline_ex(e, &_deadline)) && _deadline < until) {
+    until = _deadline;
+  }
+
+  uint64_t _now = __frost_time_tick(NULL);
+  if(until <= _now)
+    return;
+
+  switch(e->idle.strategy) {
+    case frost_idle_yield:
+      idle_yield();
+      break;
+
+    case frost_idle_park:
+
+      // announce parking before the last look at the submission queue,
+      // a submitter either sees it parked, or the task is seen here
+      #ifdef FROST_HAS_ATOMICS
+      e->idle.ctx.parked = true;
+      if(!mpsc_is_empty(e->scheduler.inbox)) {
+        e->idle.ctx.parked = false;
+        break;
+      }
+      #endif
+
+      idle_park(&e->idle.ctx, until == FROST_IDLE_INFINITE ? FROST_IDLE_INFINITE : until - _now);
+      break;
+
+    default:
+    case frost_idle_spin:
+      break;
+  }
+}
+
+/**
+ * @brief collect the tasks should run in this pass into run queue,
+ * only the expired timers are touched. if the last pass was aborted,
+ * the rest of run queue still stay and compete by urgency.
+ * the tasks cannot be queued go back to the ready list for next pass
+ *
+ * @param e engine
+ */
+static void __sched_collect(frost_engine_t* e) {
+
+  ilist_ctx_t _retry;
+  ilist_init(&_retry);
+
+  // the ready tasks
+  ilist_node_t* _node = NULL;
+  while((_node = e->scheduler.ready.head) != NULL) {
+    frost_task_ctx_t* _curctx = ilist_entry(_node, frost_task_ctx_t, sched.link);
+    __sched_unlink(_curctx);
+    if(!frost_ok(__sched_runq(_curctx)))
+      __sched_queue(_curctx, &_retry);
+  }
+
+  // the expired timers
+  wheel_node_t* _expired = NULL;
+  wheel_advance(e->scheduler.timers, e->scheduler.tick, &_expired);
+  while(_expired != NULL) {
+    wheel_node_t* _next = _expired->next;
+    frost_task_ctx_t* _curctx = (frost_task_ctx_t *)_expired->data;
+    if(!frost_ok(__sched_runq(_curctx)))
+      __sched_queue(_curctx, &_retry);
+    _expired = _next;
+  }
+
+  while((_node = _retry.head) != NULL) {
+    ilist_delete(&_retry, _node);
+    ilist_put(&e->scheduler.ready, _node);
+  }
+}
+
+static frost_errcode_t __engine_uninit(frost_engine_t* e);
+static frost_errcode_t __task_register(frost_engine_t* e, frost_task_ctx_t* ctx);
+static frost_errcode_t __task_submit(frost_engine_t* e, frost_task_ctx_t* ctx);
+static void __task_release(frost_task_ctx_t* ctx, bool local);
+
+/**
+ * @brief free the deleted tasks. the task with a queued wake up
+ * waits for the next pass to handle it, unless forced
+ *
+ * @param e engine
+ * @param force free all of them
+ */
+static void __sched_reap(frost_engine_t* e, bool force) {
+
+  frost_task_ctx_t** _link = &e->scheduler.reap;
+  while(*_link != NULL) {
+    frost_task_ctx_t* _ctx = *_link;
+
+    #ifdef FROST_HAS_ATOMICS
+    if(!force && atomic_load(&_ctx->sched.wake_queued)) {
+      _link = &_ctx->sched.reap;
+      continue;
+    }
+    #else
+    (void)force;
+    #endif
+
+    *_link = _ctx->sched.reap;
+    __task_release(_ctx, true);
+  }
+}
+
+#ifdef FROST_HAS_CORO
+/**
+ * @brief the entry of stackful task on its own stack
+ *
+ * @param arg task ctx
+ */
+static void __task_coro_entry(void* arg) {
+  __invoke_task_callback((frost_task_ctx_t *)arg);
+}
+#endif
+
+/**
+ * @brief run the task callback. the stackful task runs on its coroutine,
+ * and may come back before the callback returns. the stackless task
+ * returns with its resume point saved
+ *
+ * @param ctx task ctx
+ * @return bool if the task is suspended return true
+ */
+static bool __task_invoke(frost_task_ctx_t* ctx) {
+
+  #ifdef FROST_HAS_CORO
+  frost_engine_t* _engine = ctx->engine;
+
+  if(ctx->coro.enabled) {
+
+    // start a new run on a pooled stack, or run on the thread stack if no memory
+    if(ctx->coro.ref == NULL) {
+      if((_engine->coro_pool == NULL &&
+          !frost_ok(coro_pool_create(FROST_CORO_STACK_SIZE, FROST_CORO_POOL_SIZE, &_engine->coro_pool))) ||
+         !frost_ok(coro_create(_engine->coro_pool, __task_coro_entry, ctx, &ctx->coro.ref))) {
+        frost_log(TAG, "task '%s'[%p] cannot get a stack, run on the thread stack", ctx->name, ctx);
+        ctx->coro.ref = NULL;
+        __invoke_task_callback(ctx);
+        return false;
+      }
+    }
+
+    coro_resume(ctx->coro.ref);
+    if(!coro_is_finished(ctx->coro.ref))
+      return true;
+
+    coro_release(_engine->coro_pool, ctx->coro.ref);
+    ctx->coro.ref = NULL;
+    return ctx->coro.line != 0;
+  }
+  #endif
+
+  __invoke_task_callback(ctx);
+  return ctx->coro.line != 0;
+}
+
+/**
+ * @brief record the deadline miss of a finished run
+ *
+ * @param ctx task ctx
+ * @param due the absolute deadline
+ * @param now the tick the run finished
+ * @return uint64_t the lateness in milliseconds, 0 if in time
+ */
+static uint64_t __task_check_miss(frost_task_ctx_t* ctx, uint64_t due, uint64_t now) {
+
+  if(now <= due) {
+    ctx->miss.consecutive = 0;
+    return 0;
+  }
+
+  uint64_t _lateness = now - due;
+  ctx->miss.count++;
+  ctx->miss.consecutive++;
+  ctx->miss.total += _lateness;
+  ctx->miss.average = ctx->miss.total / ctx->miss.count;
+  if(_lateness > ctx->miss.worst) ctx->miss.worst = _lateness;
+
+  return _lateness;
+}
+
+/**
+ * @brief record the duration of a callback, the histogram is created on the first record
+ *
+ * @param ctx task ctx
+ * @param ns the duration in nanoseconds
+ */
+static void __task_profile(frost_task_ctx_t* ctx, uint64_t ns) {
+
+  if(ctx->hist == NULL && !frost_ok(hist_create(&ctx->hist))) {
+    ctx->hist = NULL;
+    return;
+  }
+
+  hist_record(ctx->hist, ns);
+}
+
+/**
+ * @brief abandon the suspended coroutine of a task, give back its stack
+ *
+ * @param ctx task ctx
+ */
+static void __task_drop_coro(frost_task_ctx_t* ctx) {
+
+  #ifdef FROST_HAS_CORO
+  if(ctx->coro.ref == NULL || ctx->sched.running)
+    return;
+
+  frost_log(TAG, "task '%s'[%p] is deleted while suspended, its stack is abandoned", ctx->name, ctx);
+  coro_release(ctx->engine->coro_pool, ctx->coro.ref);
+  ctx->coro.ref = NULL;
+  #else
+  (void)ctx;
+  #endif
+}
+
+/**
+ * @brief get the stackful task running on its coroutine of current thread
+ *
+ * @return frost_task_ctx_t* NULL if current task cannot be suspended
+ */
+static frost_task_ctx_t* __task_suspendable() {
+
+  #ifdef FROST_HAS_CORO
+  frost_engine_t* _engine = __current_engine;
+  if(_engine == NULL || executor_is_worker())
+    return NULL;
+
+  frost_task_ctx_t* _ctx = _engine->scheduler.context;
+  if(_ctx == NULL || _ctx->coro.ref == NULL || coro_current() != _ctx->coro.ref)
+    return NULL;
+
+  return _ctx;
+  #else
+  return NULL;
+  #endif
+}
+
+/**
+ * @brief initialize an engine
+ *
+ * @param e engine
+ * @return frost_errcode_t if success return ok
+ */
+static frost_errcode_t __engine_init(frost_engine_t* e) {
+
+  if(e->initialized)
     return frost_err_ok;
 
   frost_errcode_t _result;
 
-  // create task list
-  if(!frost_ok(_result = list_create(&engine.scheduler.tasks))) {
+  // create task list and scheduler queues
+  ilist_init(&e->scheduler.tasks);
+  ilist_init(&e->scheduler.ready);
+  if(!frost_ok(_result = prioq_create(&e->scheduler.runq))) {
+    frost_log(TAG, "go to failure procedure");
+    __engine_uninit(e);
+    return frost_err_fatal_error;
+  }
+
+  // create the slabs of task contexts and awaiters, and the pool of channel packs
+  if(!frost_ok(_result = slab_create(sizeof(frost_task_ctx_t), FROST_SLAB_CHUNK_SIZE, &e->pool.tasks)) ||
+     !frost_ok(_result = slab_create(sizeof(frost_awaiter_t), FROST_SLAB_CHUNK_SIZE, &e->pool.awaiters)) ||
+     !frost_ok(_result = pool_create(0, FROST_CHAN_POOL_MAX_SIZE, FROST_CHAN_POOL_CAP, &e->pool.packs))) {
+    frost_log(TAG, "go to failure procedure");
+    __engine_uninit(e);
+    return frost_err_fatal_error;
+  }
+
+  // create timer wheel
+  if(!frost_ok(_result = wheel_create(__frost_time_tick(NULL), &e->scheduler.timers))) {
+    frost_log(TAG, "go to failure procedure");
+    __engine_uninit(e);
+    return frost_err_fatal_error;
+  }
+
+  // create idle context
+  if(!frost_ok(_result = idle_create(&e->idle.ctx))) {
+    frost_log(TAG, "go to failure procedure");
+    __engine_uninit(e);
+    return frost_err_fatal_error;
+  }
+
+  // create submission queue
+  #ifdef FROST_HAS_ATOMICS
+  if(!frost_ok(_result = mpsc_create(&e->scheduler.inbox))) {
     frost_log(TAG, "go to failure procedure");
-    frost_uninit();
+    __engine_uninit(e);
     return frost_err_fatal_error;
   }
+  #endif
 
   // okay all done!
-  engine.initialized = true;
-  frost_log(TAG, "global initialization finished");
+  e->initialized = true;
+  frost_log(TAG, "engine[%p] initialization finished", e);
 
   return frost_err_ok;
 }
 
+/**
+ * @brief uninitialize an engine
+ *
+ * @param e engine
+ * @return frost_errcode_t if success return ok
+ */
+static frost_errcode_t __engine_uninit(frost_engine_t* e) {
+
+  // stop the workers first, they may still spawn tasks
+  frost_executor_stop(e);
+
+  // cancel the submitted tasks not added yet
+  #ifdef FROST_HAS_ATOMICS
+  if(e->scheduler.inbox != NULL) {
+    mpsc_node_t* _node = NULL;
+    while(frost_ok(mpsc_pop(e->scheduler.inbox, &_node))) {
+      frost_task_ctx_t* _ctx = (frost_task_ctx_t *)_node->data;
+
+      // a wake up of the registered task
+      if(_node == &_ctx->sched.wake)
+        continue;
+
+      if(_ctx->awaiter) awaiter_settle(_ctx->awaiter);
+      __task_release(_ctx, true);
+    }
+
+    mpsc_destroy(e->scheduler.inbox);
+    e->scheduler.inbox = NULL;
+  }
+  #endif
+
+  // free the deleted tasks
+  __sched_reap(e, true);
+
+  // delete all tasks, the suspended stackful tasks give back their stacks
+  ilist_node_t* _node = e->scheduler.tasks.head;
+  while(_node != NULL) {
+    frost_task_ctx_t* _ctx = ilist_entry(_node, frost_task_ctx_t, ref);
+    _node = _node->next;
+
+    __task_drop_coro(_ctx);
+    __task_release(_ctx, true);
+  }
+
+  // delete scheduler queues
+  if(e->scheduler.runq != NULL)
+    prioq_destroy(e->scheduler.runq);
+
+  if(e->scheduler.timers != NULL)
+    wheel_destroy(e->scheduler.timers);
+
+  #ifdef FROST_HAS_CORO
+  if(e->coro_pool != NULL) {
+    coro_pool_destroy(e->coro_pool);
+    e->coro_pool = NULL;
+  }
+  #endif
+
+  // the objects not given back become invalid,
+  // the awaiters must be destroyed before
+  if(e->pool.tasks != NULL)
+    slab_destroy(e->pool.tasks);
+
+  if(e->pool.awaiters != NULL)
+    slab_destroy(e->pool.awaiters);
+
+  if(e->pool.packs != NULL)
+    pool_destroy(e->pool.packs);
+
+  e->pool.tasks = NULL;
+  e->pool.awaiters = NULL;
+  e->pool.packs = NULL;
+
+  idle_destroy(&e->idle.ctx);
+  trace_destroy(&e->trace);
+
+  ilist_init(&e->scheduler.tasks);
+  ilist_init(&e->scheduler.ready);
+  e->scheduler.runq = NULL;
+  e->scheduler.timers = NULL;
+  e->scheduler.utilization = 0;
+
+  e->initialized = false;
+  frost_log(TAG, "engine[%p] uninit", e);
+
+  return frost_err_ok;
+}
+
+frost_errcode_t frost_init() {
+
+  #ifdef FROST_PORT_TIME_HIRES
+  __frost_time_calibrate();
+  #endif
+
+  return __engine_init(&engine);
+}
+
 bool frost_is_initialized() {
   return engine.initialized;
 }
 
 frost_errcode_t frost_uninit() {
+  return __engine_uninit(&engine);
+}
+
+frost_errcode_t frost_engine_create(frost_engine_t** instance) {
+
+  if(instance == NULL)
+    return frost_err_invalid_parameter;
 
-  // delete all tasks
-  if(engine.scheduler.tasks != NULL)
-    list_destroy(engine.scheduler.tasks);
+  frost_engine_t* _engine = malloc(sizeof(frost_engine_t)); {
+    if(_engine == NULL) return frost_err_out_of_memory;
+    memset(_engine, 0, sizeof(frost_engine_t));
+  }
 
-  engine.initialized = false;
-  frost_log(TAG, "global uninit");
+  frost_errcode_t _result;
+  if(!frost_ok(_result = __engine_init(_engine))) {
+    free(_engine);
+    return _result;
+  }
 
+  *instance = _engine;
+  return frost_err_ok;
+}
+
+frost_errcode_t frost_engine_destroy(frost_engine_t* instance) {
+
+  // the default engine is destroyed by frost_uninit()
+  if(instance == NULL || instance == &engine)
+    return frost_err_invalid_parameter;
+
+  __engine_uninit(instance);
+  free(instance);
+
+  return frost_err_ok;
+}
+
+frost_errcode_t frost_engine_attach(frost_engine_t* e) {
+
+  if(e != NULL && !e->initialized)
+    return frost_err_need_initialize;
+
+  __current_engine = e;
   return frost_err_ok;
 }
 
@@ -70,259 +654,777 @@ frost_errcode_t frost_get_engine(frost_engine_t** instance) {
   if(instance == NULL)
     return frost_err_invalid_parameter;
 
-  *instance = &engine;
+  *instance = __engine_current();
+  return frost_err_ok;
+}
+
+/**
+ * @brief add the tasks submitted by the other threads, and notify the tasks they woke up
+ *
+ * @param e engine
+ */
+static void __sched_drain(frost_engine_t* e) {
+
+  #ifdef FROST_HAS_ATOMICS
+  bool _is_dirty = e->scheduler.is_dirty;
+
+  mpsc_node_t* _node = NULL;
+  while(frost_ok(mpsc_pop(e->scheduler.inbox, &_node))) {
+    frost_task_ctx_t* _ctx = (frost_task_ctx_t *)_node->data;
+
+    // re-arm before notify, a later write either sees it queued
+    // or is seen by the task after it's filed
+    if(_node == &_ctx->sched.wake) {
+      atomic_store(&_ctx->sched.wake_queued, 0);
+      frost_task_notify(_ctx);
+      continue;
+    }
+
+    if(!frost_ok(__task_register(e, _ctx))) {
+      frost_log(TAG, "submitted task '%s'[%p] cannot be added, cancel it", _ctx->name, _ctx);
+      if(_ctx->awaiter) awaiter_settle(_ctx->awaiter);
+      __task_release(_ctx, true);
+    }
+  }
+
+  // the pass has not started, nothing to reset
+  e->scheduler.is_dirty = _is_dirty;
+  #endif
+}
+
+frost_errcode_t frost_schedule_tasks_ex(frost_engine_t* e) {
+
+  if(e == NULL)
+    return frost_err_invalid_parameter;
+  else if(!e->initialized)
+    return frost_err_need_initialize;
+
+  bool _is_realtime = true;
+  uint64_t _time_measure_start = 0;
+
+  // the tasks call the global api on this engine
+  frost_engine_t* _oldengine = __current_engine;
+  __current_engine = e;
+  ++e->scheduler.depth;
+
+  // collect the tasks due in this pass
+  e->scheduler.tick = __frost_time_tick(NULL);
+  __sched_drain(e);
+  __sched_collect(e);
+
+  // the idle passes are not traced
+  bool _traced = e->trace.enabled && e->scheduler.runq->size != 0;
+  uint32_t _runs = 0;
+  if(_traced) trace_record(&e->trace, frost_trace_pass_begin, NULL, NULL, 0);
+
+  // run the highest priority first, the most urgent task first in a priority (soft-EDF)
+  heap_node_t* _node = NULL;
+  while(frost_ok(prioq_pop(e->scheduler.runq, &_node))) {
+
+    frost_task_ctx_t* _curctx = (frost_task_ctx_t *)_node->data; {
+
+      // get current tick time, the snapshot mode reuses
+      // the sample of pass start or the previous callback return
+      #if !FROST_TIME_SNAPSHOT
+      e->scheduler.tick = __frost_time_tick(NULL);
+      #endif
+      _time_measure_start = e->scheduler.tick;
+
+      #ifdef FROST_DEBUG
+      _curctx->fire++;
+      #endif /* FROST_DEBUG */
+
+      // update the new context then run the task,
+      // and restore the old context finally
+      frost_task_ctx_t* _oldctx = e->scheduler.context; {
+        e->scheduler.context = _curctx;
+        _curctx->sched.running = true;
+        frost_trace(e, frost_trace_task_start, _curctx, (void *)_curctx->callback, 0);
+        // the callback may toggle the profiling, keep the state it started with
+        bool _profiling = e->scheduler.profiling;
+        uint64_t _ns = _profiling ? __frost_time_ns() : 0;
+        bool _suspended = __task_invoke(_curctx);
+        if(_profiling) __task_profile(_curctx, __frost_time_ns() - _ns);
+        frost_trace(e, frost_trace_task_end, _curctx, (void *)_curctx->callback, _suspended);
+        ++_runs;
+        _curctx->sched.running = false;
+        e->scheduler.context = _oldctx;
+
+        #if FROST_TIME_SNAPSHOT
+        e->scheduler.tick = __frost_time_tick(NULL);
+        #endif
+
+        // the task has deleted itself
+        if(_curctx->sched.deleted) {
+          __task_drop_coro(_curctx);
+        }
+
+        // the stackful or stackless task has suspended, wait for the resume tick
+        else if(_suspended) {
+          __sched_file(_curctx);
+        }
+
+        // refill the tick time
+        else if (_curctx->refill) {
+
+          #if !FROST_TIME_SNAPSHOT
+          e->scheduler.tick = __frost_time_tick(NULL);
+          #endif
+
+          uint64_t _lateness = __task_check_miss(_curctx, __task_deadline(_curctx), e->scheduler.tick);
+
+          if(_curctx->score > 0)
+            _curctx->tick += _curctx->interval;
+          else
+            _curctx->tick = _time_measure_start - _curctx->exec_time + _curctx->interval;
+
+          // calculate score
+          _curctx->exec_time = e->scheduler.tick - _time_measure_start;
+          _curctx->score = _curctx->tick - e->scheduler.tick;
+
+          // wait for the next tick
+          __sched_file(_curctx);
+
+          // the task is filed, the callback may delete it
+          if(_lateness != 0 && e->scheduler.on_miss != NULL)
+            e->scheduler.on_miss(_curctx, _lateness);
+        }
+
+        // if this task marked as one-shot task, remove it from the list
+        else {
+          frost_task_delete(_curctx);
+        }
+      }
+
+      // if the task list is changed in the previous task (add task / del task)
+      // drop current context and re-run the rest of run queue next time
+      if(e->scheduler.is_dirty) {
+        frost_log(TAG, "scheduler has been marked as 'dirty' state, reset context");
+        frost_trace(e, frost_trace_pass_dirty, NULL, NULL, 0);
+        e->scheduler.is_dirty = false;
+        break;
+      }
+
+      // record realtime state
+      if (_is_realtime && _curctx->score < 0) {
+        _is_realtime = false;
+      }
+    }
+
+    e->scheduler.is_realtime = _is_realtime;
+  }
+
+  if(_traced) trace_record(&e->trace, frost_trace_pass_end, NULL, NULL, _runs);
+
+  e->scheduler.context = NULL;
+  __current_engine = _oldengine;
+
+  // the outer passes may still hold the deleted tasks
+  if(--e->scheduler.depth == 0)
+    __sched_reap(e, false);
+
   return frost_err_ok;
 }
 
 frost_errcode_t frost_schedule_tasks() {
+  return frost_schedule_tasks_ex(__engine_current());
+}
+
+frost_errcode_t frost_task_get_context(frost_task_ctx_t** task) {
+
+  frost_engine_t* _engine = __engine_current();
+
+  if(task == NULL)
+    return frost_err_invalid_parameter;
+  else if(!_engine->initialized)
+    return frost_err_need_initialize;
+
+  // the task running on an executor worker
+  if(executor_is_worker()) {
+    *task = executor_context();
+    return frost_err_ok;
+  }
+
+  // get current task context, a thread not scheduling the engine has no context
+  *task = __current_engine == _engine ? _engine->scheduler.context : NULL;
+
+  return frost_err_ok;
+}
+
+/**
+ * @brief allocate a task context, it's safe to call from any thread.
+ * the context and awaiter come from the slabs of engine on the engine thread
+ *
+ * @param e engine
+ * @param remote called by a foreign thread
+ * @param func task callback
+ * @param refill periodic task, otherwise an one-shot task with awaiter
+ * @param interval interval in milliseconds
+ * @param argc argument count
+ * @param args arguments, can be NULL if argc is 0
+ * @param ctx return the task context
+ * @return frost_errcode_t if success return ok
+ */
+static frost_errcode_t __task_create(frost_engine_t* e, bool remote, void* func, bool refill,
+  uint32_t interval, uint32_t argc, va_list* args, frost_task_ctx_t** ctx) {
+
+  frost_awaiter_t* _awaiter = NULL;
+
+  // the slabs are owned by the engine thread
+  bool _pooled = !remote && !executor_is_worker();
+
+  // create an awaiter for one-shot task,
+  // it's settled by the scheduler after the task returns
+  if(!refill) {
+    if((_awaiter = awaiter_alloc(_pooled ? e->pool.awaiters : NULL)) == NULL)
+      return frost_err_out_of_memory;
+  }
+
+  // create a new task
+  void* _task = NULL;
+  if(!_pooled || !frost_ok(slab_alloc(e->pool.tasks, &_task))) {
+    _pooled = false;
+    _task = malloc(sizeof(frost_task_ctx_t));
+  }
+
+  if(_task == NULL) {
+    if(_awaiter) awaiter_destroy(_awaiter);
+    return frost_err_out_of_memory;
+  }
+
+  if(_awaiter) awaiter_bind(_awaiter);
+
+  // setup task information
+  frost_task_ctx_t* _task_ptr = (frost_task_ctx_t *)_task; {
+    memset(_task_ptr, 0x00, sizeof(frost_task_ctx_t));
+    _task_ptr->engine = e;
+    _task_ptr->pooled = _pooled;
+    _task_ptr->priority = FROST_PRIORITY_DEFAULT;
+    _task_ptr->callback = func;
+    _task_ptr->awaiter = _awaiter;
+
+    if(!refill) {
+      _task_ptr->name = "<async task>";
+      _task_ptr->refill = false;
+    }
+
+    else {
+      _task_ptr->name = "<interval>";
+      _task_ptr->refill = true;
+      _task_ptr->interval = interval;
+      _task_ptr->tick = __frost_time_tick(NULL) + interval;
+      _task_ptr->score = interval;
+    }
+
+    // copy arguments
+    _task_ptr->args.argc = argc; {
+      for(size_t i = 0; i < argc; ++i) {
+        _task_ptr->args.argv[i] = va_arg(*args, void *);
+      }
+    }
+  }
+
+  *ctx = _task_ptr;
+  return frost_err_ok;
+}
+
+/**
+ * @brief give back the memory of task context
+ *
+ * @param ctx task context
+ * @param local called by the engine thread
+ */
+static void __task_release(frost_task_ctx_t* ctx, bool local) {
+
+  if(ctx->hist != NULL)
+    hist_destroy(ctx->hist);
+
+  if(!ctx->pooled)
+    free(ctx);
+  else if(local)
+    slab_free(ctx->engine->pool.tasks, ctx);
+  else
+    slab_free_remote(ctx->engine->pool.tasks, ctx);
+}
+
+/**
+ * @brief free a task context never scheduled, on the thread created it
+ *
+ * @param ctx task context
+ */
+static void __task_free(frost_task_ctx_t* ctx) {
+
+  // never handed out, drop the references of both task and caller
+  if(ctx->awaiter) {
+    awaiter_settle(ctx->awaiter);
+    awaiter_destroy(ctx->awaiter);
+  }
+
+  __task_release(ctx, true);
+}
+
+/**
+ * @brief add a new task into the engine, the one-shot task runs in next pass,
+ * or on the workers if the executor is started. on a worker the other tasks
+ * are submitted to the engine thread
+ *
+ * @param e engine
+ * @param ctx task context
+ * @return frost_errcode_t if success return ok
+ */
+static frost_errcode_t __task_register(frost_engine_t* e, frost_task_ctx_t* ctx) {
+
+  frost_errcode_t _result;
+
+  // run it on the workers, the executor owns the task.
+  // a sleeping stackless task handed back by the executor stays in the wheel
+  if(!ctx->refill && !ctx->coro.enabled && ctx->coro.line == 0 && e->executor != NULL)
+    return executor_submit(e->executor, ctx);
+
+  // the engine lists are owned by the engine thread, a worker hands it over
+  if(executor_is_worker())
+    return __task_submit(e, ctx);
+
+  // append new task to scheduler
+  if(!frost_ok(_result = ilist_put(&e->scheduler.tasks, &ctx->ref))) {
+    return _result;
+  }
+
+  e->scheduler.utilization += ctx->utilization;
+
+  frost_trace(e, frost_trace_task_spawn, ctx, (void *)ctx->callback, 0);
+
+  // the one-shot task runs in next pass,
+  // the interval task waits for the first tick
+  if(!ctx->refill) ctx->tick = e->scheduler.tick;
+  __sched_file(ctx);
+  __sched_wakeup(e);
+
+  // request update scheduler context
+  e->scheduler.is_dirty = true;
+  frost_log(TAG, "mark scheduler context as 'dirty' state");
+  frost_log(TAG, "current task size => %zu", e->scheduler.tasks.size);
+
+  return frost_err_ok;
+}
+
+/**
+ * @brief create an one-shot task on the engine
+ *
+ * @param e engine
+ * @param func task callback
+ * @param stackful run on its own stack
+ * @param argc argument count
+ * @param args arguments
+ * @return frost_awaiter_t*
+ */
+static frost_awaiter_t* __task_spawn(frost_engine_t* e, void* func, bool stackful, uint32_t argc, va_list args) {
+
+  if(e == NULL)
+    return awaiter_from_value(NULL, frost_err_invalid_parameter);
+  else if(!e->initialized)
+    return awaiter_from_value(NULL, frost_err_need_initialize);
+
+  frost_log(TAG, "create async task using callback address [%p]", func);
+
+  frost_task_ctx_t* _task = NULL;
+  frost_errcode_t _result;
+
+  // va_list may be an array type, copy it to take the address
+  va_list _args;
+  va_copy(_args, args);
+  _result = __task_create(e, false, func, false, 0, argc, &_args, &_task);
+  va_end(_args);
+
+  if(!frost_ok(_result))
+    return awaiter_from_value(NULL, _result);
+
+  #ifdef FROST_HAS_CORO
+  _task->coro.enabled = stackful;
+  #else
+  if(stackful) {
+    frost_log(TAG, "stackful task is not supported on this platform");
+    __task_free(_task);
+    return awaiter_from_value(NULL, frost_err_fatal_error);
+  }
+  #endif
+
+  frost_awaiter_t* _awaiter = _task->awaiter;
+  if(!frost_ok(_result = __task_register(e, _task))) {
+    __task_free(_task);
+    return awaiter_from_value(NULL, _result);
+  }
+
+  return _awaiter;
+}
+
+frost_awaiter_t* frost_task_spawn_ex(frost_engine_t* e, void* func, uint32_t argc, ...) {
+
+  va_list _args;
+  va_start(_args, argc);
+  frost_awaiter_t* _awaiter = __task_spawn(e, func, false, argc, _args);
+  va_end(_args);
+
+  return _awaiter;
+}
+
+frost_awaiter_t* frost_task_run_ex(void* func, uint32_t argc, ...) {
+
+  va_list _args;
+  va_start(_args, argc);
+  frost_awaiter_t* _awaiter = __task_spawn(__engine_current(), func, false, argc, _args);
+  va_end(_args);
+
+  return _awaiter;
+}
+
+frost_awaiter_t* frost_task_run(void* func) {
+  return frost_task_run_ex(func, 0);
+}
+
+frost_awaiter_t* frost_task_spawn_stackful_ex(frost_engine_t* e, void* func, uint32_t argc, ...) {
+
+  va_list _args;
+  va_start(_args, argc);
+  frost_awaiter_t* _awaiter = __task_spawn(e, func, true, argc, _args);
+  va_end(_args);
+
+  return _awaiter;
+}
+
+frost_awaiter_t* frost_task_run_stackful_ex(void* func, uint32_t argc, ...) {
+
+  va_list _args;
+  va_start(_args, argc);
+  frost_awaiter_t* _awaiter = __task_spawn(__engine_current(), func, true, argc, _args);
+  va_end(_args);
+
+  return _awaiter;
+}
+
+frost_awaiter_t* frost_task_run_stackful(void* func) {
+  return frost_task_run_stackful_ex(func, 0);
+}
+
+frost_errcode_t frost_task_set_stackful(frost_task_ctx_t* task) {
+
+  if(task == NULL)
+    return frost_err_invalid_parameter;
+
+  #ifdef FROST_HAS_CORO
+  task->coro.enabled = true;
+  return frost_err_ok;
+  #else
+  frost_log(TAG, "stackful task is not supported on this platform");
+  return frost_err_fatal_error;
+  #endif
+}
+
+frost_errcode_t frost_task_interval_ex(frost_engine_t* e, uint32_t interval, void* func, frost_task_ctx_t** task) {
+
+  if(e == NULL)
+    return frost_err_invalid_parameter;
+  else if(!e->initialized)
+    return frost_err_need_initialize;
+
+  frost_log(TAG, "create interval task using callback address"
+                 "[%p], interval %zu ms", func, interval);
+
+  frost_task_ctx_t* _task = NULL;
+  frost_errcode_t _result;
+
+  if(!frost_ok(_result = __task_create(e, false, func, true, interval, 0, NULL, &_task)))
+    return _result;
+
+  if(!frost_ok(_result = __task_register(e, _task))) {
+    __task_free(_task);
+    return _result;
+  }
+
+  // if task not NULL then return task pointer
+  if(task != NULL) *task = _task;
+
+  return frost_err_ok;
+}
+
+frost_errcode_t frost_task_interval(uint32_t interval, void* func, frost_task_ctx_t** task) {
+  return frost_task_interval_ex(__engine_current(), interval, func, task);
+}
+
+frost_errcode_t frost_task_realtime_ex(frost_engine_t* e, uint32_t period, uint32_t deadline,
+  uint32_t budget, void* func, frost_task_ctx_t** task) {
+
+  if(e == NULL || period == 0)
+    return frost_err_invalid_parameter;
+  else if(!e->initialized)
+    return frost_err_need_initialize;
+
+  if(deadline == 0)
+    deadline = period;
+
+  // the density bound, sufficient for the constrained deadlines
+  uint64_t _utilization = (uint64_t)budget * 1000 / (deadline < period ? deadline : period);
+  if(e->scheduler.utilization + _utilization > FROST_EDF_BOUND) {
+    frost_log(TAG, "realtime task [%p] rejected, utilization %llu + %llu ppm exceeds the bound",
+              func, (unsigned long long)e->scheduler.utilization, (unsigned long long)_utilization);
+    return frost_err_overload;
+  }
+
+  frost_task_ctx_t* _task = NULL;
+  frost_errcode_t _result;
+
+  if(!frost_ok(_result = __task_create(e, false, func, true, period, 0, NULL, &_task)))
+    return _result;
+
+  _task->deadline = deadline;
+  _task->utilization = (uint32_t)_utilization;
+
+  frost_log(TAG, "realtime task '%s'[%p] admitted, utilization %llu ppm", _task->name, _task,
+            (unsigned long long)(e->scheduler.utilization + _utilization));
+
+  // the utilization is accounted when it's added to the engine
+  if(!frost_ok(_result = __task_register(e, _task))) {
+    __task_free(_task);
+    return _result;
+  }
+
+  if(task != NULL) *task = _task;
+
+  return frost_err_ok;
+}
+
+frost_errcode_t frost_task_realtime(uint32_t period, uint32_t deadline, uint32_t budget, void* func, frost_task_ctx_t** task) {
+  return frost_task_realtime_ex(__engine_current(), period, deadline, budget, func, task);
+}
+
+frost_errcode_t frost_get_utilization_ex(frost_engine_t* e, uint64_t* utilization) {
+
+  if(e == NULL || utilization == NULL)
+    return frost_err_invalid_parameter;
+  else if(!e->initialized)
+    return frost_err_need_initialize;
+
+  *utilization = e->scheduler.utilization;
+  return frost_err_ok;
+}
+
+frost_errcode_t frost_get_utilization(uint64_t* utilization) {
+  return frost_get_utilization_ex(__engine_current(), utilization);
+}
+
+frost_errcode_t frost_set_miss_callback_ex(frost_engine_t* e, frost_miss_callback_t callback) {
+
+  if(e == NULL)
+    return frost_err_invalid_parameter;
+  else if(!e->initialized)
+    return frost_err_need_initialize;
+
+  e->scheduler.on_miss = callback;
+  return frost_err_ok;
+}
+
+frost_errcode_t frost_set_miss_callback(frost_miss_callback_t callback) {
+  return frost_set_miss_callback_ex(__engine_current(), callback);
+}
+
+frost_errcode_t frost_set_profiling_ex(frost_engine_t* e, bool enabled) {
+
+  if(e == NULL)
+    return frost_err_invalid_parameter;
+  else if(!e->initialized)
+    return frost_err_need_initialize;
+
+  e->scheduler.profiling = enabled;
+  return frost_err_ok;
+}
+
+frost_errcode_t frost_set_profiling(bool enabled) {
+  return frost_set_profiling_ex(__engine_current(), enabled);
+}
+
+frost_errcode_t frost_trace_start_ex(frost_engine_t* e, size_t capacity) {
 
-  if(!engine.initialized)
+  if(e == NULL)
+    return frost_err_invalid_parameter;
+  else if(!e->initialized)
     return frost_err_need_initialize;
 
-  bool _is_realtime = true;
-  int64_t _last_score = 0;
-  uint64_t _time_measure_start = 0;
+  if(capacity == 0)
+    capacity = FROST_TRACE_SIZE;
 
-  list_node_t* _node = engine.scheduler.tasks->head;
-  while(_node != NULL) {
+  // keep the ring if the capacity is not changed
+  if(e->trace.events == NULL || capacity > e->trace.mask + 1 || capacity <= (e->trace.mask + 1) >> 1) {
+    frost_errcode_t _result;
+    trace_destroy(&e->trace);
+    if(!frost_ok(_result = trace_create(&e->trace, capacity)))
+      return _result;
+  }
 
-    frost_task_ctx_t* _curctx = *(frost_task_ctx_t **)_node->data; {
+  e->trace.count = 0;
+  e->trace.enabled = true;
+  return frost_err_ok;
+}
 
-      // do not invoke itself
-      if(engine.scheduler.context == _curctx)
-        goto next;
+frost_errcode_t frost_trace_start(size_t capacity) {
+  return frost_trace_start_ex(__engine_current(), capacity);
+}
 
-      // for frozen task
-      else if (__fflag(_curctx, frost_flag_freeze)) {
+frost_errcode_t frost_trace_stop_ex(frost_engine_t* e) {
 
-        // if not set chan write unfreeze, jump into next
-        if(!__fflag(_curctx, frost_flag_unfreeze_by_chan_write)) {
-          goto next;
-        }
+  if(e == NULL)
+    return frost_err_invalid_parameter;
 
-        // dont unfreeze case
-        if(!_curctx->chan.ref || _curctx->chan.ref->notify_cnt <= 0) {
-          if(!_curctx->chan.ref) {
-            //frost_log(TAG, "task[%p] set 'unfreeze_by_chan_write' but no channel allocated", _curctx);
-          }
-          goto next;
-        }
+  e->trace.enabled = false;
+  return frost_err_ok;
+}
 
-        // sync the tick to scheduler main tick to fire the task immediately
-        _curctx->tick = engine.scheduler.tick;
-      }
+frost_errcode_t frost_trace_stop() {
+  return frost_trace_stop_ex(__engine_current());
+}
 
-      // get current tick time
-      uint64_t _time = __frost_time_tick(NULL); {
-        engine.scheduler.tick = _time; {
-          _time_measure_start = engine.scheduler.tick;
-        }
-      }
+frost_errcode_t frost_trace_export_ex(frost_engine_t* e, frost_trace_writer_t writer, void* user) {
 
-      // it's time to do something? :p
-      if(_curctx->interval == 0 || engine.scheduler.tick >= _curctx->tick) {
-
-        #ifdef FROST_DEBUG
-        _curctx->fire++;
-        #endif /* FROST_DEBUG */
-
-        // update the new context then run the task,
-        // and restore the old context finally
-        frost_task_ctx_t* _oldctx = engine.scheduler.context; {
-          engine.scheduler.context = _curctx;
-          __invoke_task_callback(_curctx);
-          engine.scheduler.context = _oldctx;
-
-          // refill the tick time
-          if (_curctx->refill) {
-
-            if(_curctx->score > 0)
-              _curctx->tick += _curctx->interval;
-            else
-              _curctx->tick = engine.scheduler.tick - _curctx->exec_time + _curctx->interval;
-
-            // calculate score
-            engine.scheduler.tick = __frost_time_tick(NULL); {
-              _curctx->exec_time = engine.scheduler.tick - _time_measure_start;
-              _curctx->score = _curctx->tick - engine.scheduler.tick;
-            }
-          }
-
-          // if this task marked as one-shot task, remove it from the list
-          else {
-            frost_task_delete(_curctx);
-          }
-        }
+  if(e == NULL)
+    return frost_err_invalid_parameter;
 
-        // if the task list is changed in the previous task (add task / del task)
-        // drop current context and re-run it next time
-        if(engine.scheduler.is_dirty) {
-          frost_log(TAG, "scheduler has been marked as 'dirty' state, reset context");
-          engine.scheduler.context = NULL;
-          engine.scheduler.is_dirty = false;
-          return frost_err_ok;
-        }
-      }
+  return trace_export(&e->trace, writer, user);
+}
 
-      // raise priority
-      // preemptive control
-      if (_curctx->score < _last_score) {
-        list_move_forward(engine.scheduler.tasks, _node);
-      }
+frost_errcode_t frost_trace_export(frost_trace_writer_t writer, void* user) {
+  return frost_trace_export_ex(__engine_current(), writer, user);
+}
 
-      // record score for next use
-      _last_score = _curctx->score;
-      if (_is_realtime && _curctx->score < 0) {
-        _is_realtime = false;
-      }
-    }
+frost_errcode_t frost_task_get_profile(frost_task_ctx_t* task, frost_task_profile_t* profile) {
 
-    // next task
-  next:
+  if(task == NULL || profile == NULL)
+    return frost_err_invalid_parameter;
 
-    // get current tick time
-    engine.scheduler.is_realtime = _is_realtime;
-    _node = _node->next;
-  }
+  if(task->hist == NULL || task->hist->count == 0)
+    return frost_err_eof;
+
+  profile->count = task->hist->count;
+  profile->max = task->hist->max;
+  hist_quantile(task->hist, 500000, &profile->p50);
+  hist_quantile(task->hist, 990000, &profile->p99);
+  hist_quantile(task->hist, 999000, &profile->p999);
 
-  engine.scheduler.context = NULL;
   return frost_err_ok;
 }
 
-frost_errcode_t frost_task_get_context(frost_task_ctx_t** task) {
+frost_errcode_t frost_task_reset_profile(frost_task_ctx_t* task) {
 
   if(task == NULL)
     return frost_err_invalid_parameter;
-  else if(!engine.initialized)
-    return frost_err_need_initialize;
 
-  // get current task context
-  *task = engine.scheduler.context;
-
-  return frost_err_ok;
+  return task->hist != NULL ? hist_reset(task->hist) : frost_err_ok;
 }
 
-frost_awaiter_t* frost_task_run_ex(void* func, uint32_t argc, ...) {
-
-  if(!engine.initialized)
-    return awaiter_from_value(NULL, frost_err_need_initialize);
-
-  // create an awaiter for task
-  frost_awaiter_t* _awaiter = awaiter_create(); {
-    if(_awaiter == NULL) return awaiter_from_value(NULL, frost_err_out_of_memory);
-  }
+/**
+ * @brief submit a task context to the engine
+ *
+ * @param e engine
+ * @param ctx task context
+ * @return frost_errcode_t if success return ok
+ */
+static frost_errcode_t __task_submit(frost_engine_t* e, frost_task_ctx_t* ctx) {
 
-  // create a new task
-  frost_handle_t _task = malloc(sizeof(frost_task_ctx_t)); {
-    if(_task == NULL) {
-      awaiter_destroy(_awaiter);
-      return awaiter_from_value(NULL, frost_err_out_of_memory);
-    }
-  }
+  #ifdef FROST_HAS_ATOMICS
+  if(ctx->awaiter) ctx->awaiter->is_remote = true;
+  __sched_post(e, &ctx->sched.inbox, ctx);
 
-  frost_log(TAG, "create async task using callback address [%p]", func);
+  return frost_err_ok;
+  #else
+  (void)e; (void)ctx;
+  frost_log(TAG, "task submission requires C11 atomics");
+  return frost_err_fatal_error;
+  #endif
+}
 
-  // setup task information
-  frost_task_ctx_t* _task_ptr = (frost_task_ctx_t *)_task; {
-    memset(_task_ptr, 0x00, sizeof(frost_task_ctx_t));
-    _task_ptr->callback = func;
-    _task_ptr->awaiter = _awaiter;
-    _task_ptr->refill = false;
-    _task_ptr->name = "<async task>";
+frost_awaiter_t* frost_task_submit_ex(frost_engine_t* e, void* func, uint32_t argc, ...) {
 
-    va_list _args;
-    va_start(_args, argc);
+  if(e == NULL)
+    return awaiter_from_value(NULL, frost_err_invalid_parameter);
+  else if(!e->initialized)
+    return awaiter_from_value(NULL, frost_err_need_initialize);
 
-    // copy arguments
-    _task_ptr->args.argc = argc; {
-      for(size_t i = 0; i < argc; ++i) {
-        _task_ptr->args.argv[i] = va_arg(_args, void *);
-      }
-    }
+  frost_task_ctx_t* _task = NULL;
+  frost_errcode_t _result;
 
-    va_end(_args);
-  }
+  va_list _args;
+  va_start(_args, argc);
+  _result = __task_create(e, true, func, false, 0, argc, &_args, &_task);
+  va_end(_args);
 
-  frost_errcode_t _result;
+  if(!frost_ok(_result))
+    return awaiter_from_value(NULL, _result);
 
-  // append new task to scheduler
-  if(!frost_ok(_result = list_put(engine.scheduler.tasks, &_task_ptr,
-     sizeof(frost_task_ctx_t *), &_task_ptr->ref))) {
-    free(_task);
-    awaiter_destroy(_awaiter);
+  frost_awaiter_t* _awaiter = _task->awaiter;
+  if(!frost_ok(_result = __task_submit(e, _task))) {
+    __task_free(_task);
     return awaiter_from_value(NULL, _result);
   }
 
-  // request update scheduler context
-  engine.scheduler.is_dirty = true;
-  frost_log(TAG, "mark scheduler context as 'dirty' state");
-  frost_log(TAG, "current task size => %zu", engine.scheduler.tasks->size);
-
   return _awaiter;
 }
 
-frost_awaiter_t* frost_task_run(void* func) {
-  return frost_task_run_ex(func, 0);
+frost_awaiter_t* frost_task_submit(void* func) {
+  return frost_task_submit_ex(__engine_current(), func, 0);
 }
 
-frost_errcode_t frost_task_interval(uint32_t interval, void* func, frost_task_ctx_t** task) {
+frost_errcode_t frost_task_submit_interval_ex(frost_engine_t* e, uint32_t interval, void* func) {
 
-  if(!engine.initialized)
+  if(e == NULL)
+    return frost_err_invalid_parameter;
+  else if(!e->initialized)
     return frost_err_need_initialize;
 
-  // create a new task
-  frost_handle_t _task = malloc(sizeof(frost_task_ctx_t)); {
-    if(_task == NULL) return frost_err_out_of_memory;
-  }
-
-  frost_log(TAG, "create interval task using callback address"
-                 "[%p], interval %zu ms", func, interval);
-
-  // setup task information
-  frost_task_ctx_t* _task_ptr = (frost_task_ctx_t *)_task; {
-    memset(_task_ptr, 0x00, sizeof(frost_task_ctx_t));
-    _task_ptr->name = "<interval>";
-    _task_ptr->callback = func;
-    _task_ptr->refill = true;
-    _task_ptr->interval = interval;
-    _task_ptr->tick = __frost_time_tick(NULL) + interval;
-    _task_ptr->score = interval;
-  }
-
+  frost_task_ctx_t* _task = NULL;
   frost_errcode_t _result;
 
-  // append new task to scheduler
-  if(!frost_ok(_result = list_put(engine.scheduler.tasks, &_task_ptr,
-     sizeof(frost_task_ctx_t *), &_task_ptr->ref))) {
-    free(_task);
+  if(!frost_ok(_result = __task_create(e, true, func, true, interval, 0, NULL, &_task)))
     return _result;
-  }
-
-  // if task not NULL then return task pointer
-  if(task != NULL) *task = _task_ptr;
 
-  // request update scheduler context
-  engine.scheduler.is_dirty = true;
-  frost_log(TAG, "mark scheduler context as 'dirty' state");
-  frost_log(TAG, "current task size => %zu", engine.scheduler.tasks->size);
+  if(!frost_ok(_result = __task_submit(e, _task))) {
+    __task_free(_task);
+    return _result;
+  }
 
   return frost_err_ok;
 }
 
 frost_errcode_t frost_task_delete(frost_task_ctx_t* task) {
 
-  if(!engine.initialized)
+  if(task == NULL)
+    return frost_err_invalid_parameter;
+  else if(!task->engine->initialized)
     return frost_err_need_initialize;
 
+  // the deleted task, or the executor task which is not in the registry
+  if(task->sched.deleted || !ilist_is_linked(&task->ref))
+    return frost_err_invalid_parameter;
+
   frost_log(TAG, "perform task '%s'[%p] deletion", task->name, task);
 
+  frost_engine_t* _engine = task->engine;
   frost_errcode_t _result;
 
+  frost_trace(_engine, frost_trace_task_delete, task, (void *)task->callback, 0);
+
   // remove task from scheduler
-  if(!frost_ok(_result = list_delete(engine.scheduler.tasks, task->ref))) {
+  if(!frost_ok(_result = ilist_delete(&_engine->scheduler.tasks, &task->ref))) {
     return _result;
   }
 
+  // cancel the pending timer or queued run,
+  // the running stackful task gives back its stack after it comes back
+  __sched_unlink(task);
+  __task_drop_coro(task);
+  task->sched.deleted = true;
+
+  // give back the admitted utilization
+  _engine->scheduler.utilization -= task->utilization;
+  task->utilization = 0;
+
   // why not delete awaiter here?
 
   // because users always use an await function to wait task to finish,
@@ -333,17 +1435,20 @@ frost_errcode_t frost_task_delete(frost_task_ctx_t* task) {
 
   if(task->awaiter) {
 
-    if(!task->awaiter->is_finished) {
-      frost_log(TAG, "awaiter is not finished, force marked as cancel state");
-
-      // let caller to cleanup
-      awaiter_cancel(task->awaiter);
-    }
+    // publish the result, or mark it as cancel state if the task has not
+    // finished it. the caller may destroy it right after, don't touch it anymore
+    awaiter_settle(task->awaiter);
 
     // awaiter_destroy(task->awaiter);
     // task->awaiter = NULL;
   }
 
+  // stop waiting for a full channel
+  if(task->chan.wait) {
+    ilist_delete(&task->chan.wait->blocked, &task->chan.wait_link);
+    task->chan.wait = NULL;
+  }
+
   // clean up tls storage
   if(task->tls) {
 
@@ -365,79 +1470,362 @@ frost_errcode_t frost_task_delete(frost_task_ctx_t* task) {
     task->chan.bind = NULL;
   }
 
+  // the scheduler may still hold it, free it after the pass
+  task->sched.reap = _engine->scheduler.reap;
+  _engine->scheduler.reap = task;
+
   // request update scheduler context
-  engine.scheduler.is_dirty = true;
+  _engine->scheduler.is_dirty = true;
   frost_log(TAG, "mark scheduler context as 'dirty' state");
-  frost_log(TAG, "current task size => %zu", engine.scheduler.tasks->size);
+  frost_log(TAG, "current task size => %zu", _engine->scheduler.tasks.size);
+
+  return frost_err_ok;
+}
+
+frost_errcode_t frost_task_release(frost_task_ctx_t* task) {
+
+  if(task == NULL || ilist_is_linked(&task->ref))
+    return frost_err_invalid_parameter;
+
+  __task_release(task, false);
+  return frost_err_ok;
+}
+
+frost_errcode_t frost_task_defer(frost_task_ctx_t* task) {
+
+  if(task == NULL || ilist_is_linked(&task->ref))
+    return frost_err_invalid_parameter;
+
+  #ifdef FROST_HAS_ATOMICS
+  // not a remote submission, the engine thread may await it
+  __sched_post(task->engine, &task->sched.inbox, task);
+  return frost_err_ok;
+  #else
+  return frost_err_fatal_error;
+  #endif
+}
+
+frost_errcode_t frost_task_notify(frost_task_ctx_t* task) {
+
+  if(task == NULL)
+    return frost_err_invalid_parameter;
+  else if(!task->engine->initialized)
+    return frost_err_need_initialize;
+
+  // only a parked task needs a wake up,
+  // the queued or running one will see the packs itself
+  if(ilist_is_linked(&task->sched.link) || heap_is_queued(&task->sched.urgency) ||
+     task->sched.running || task->sched.deleted)
+    return frost_err_ok;
+
+  if(!__fflag(task, frost_flag_freeze) || !__fflag(task, frost_flag_unfreeze_by_chan_write))
+    return frost_err_ok;
+
+  frost_errcode_t _result = __sched_file(task);
+  __sched_wakeup(task->engine);
+
+  return _result;
+}
+
+frost_errcode_t frost_task_notify_remote(frost_task_ctx_t* task) {
+
+  if(task == NULL)
+    return frost_err_invalid_parameter;
+  else if(!task->engine->initialized)
+    return frost_err_need_initialize;
+
+  #ifdef FROST_HAS_ATOMICS
+  // the queued wake up has not been handled, it will see the packs
+  if(atomic_exchange(&task->sched.wake_queued, 1))
+    return frost_err_ok;
 
+  __sched_post(task->engine, &task->sched.wake, task);
   return frost_err_ok;
+  #else
+  return frost_task_notify(task);
+  #endif
 }
 
 frost_errcode_t frost_task_set_flag(frost_task_ctx_t* task, frost_flag_t flag) {
 
   if(task == NULL)
     return frost_err_invalid_parameter;
-  else if(!engine.initialized)
+  else if(!task->engine->initialized)
     return frost_err_need_initialize;
 
+  // freeze or unfreeze takes effect immediately
+  if((flag ^ task->flags) & frost_flag_freeze) {
+    if(flag & frost_flag_freeze)
+      frost_trace(task->engine, frost_trace_task_freeze, task, NULL, 0);
+    else
+      frost_trace(task->engine, frost_trace_task_unfreeze, task, NULL, 0);
+  }
+
   task->flags = flag;
-  return frost_err_ok;
+  return __sched_file(task);
 }
 
 frost_errcode_t frost_task_get_flag(frost_task_ctx_t* task, frost_flag_t* flag) {
 
   if(task == NULL || flag == NULL)
     return frost_err_invalid_parameter;
-  else if(!engine.initialized)
+  else if(!task->engine->initialized)
     return frost_err_need_initialize;
 
   *flag = task->flags;
   return frost_err_ok;
 }
 
+frost_errcode_t frost_task_set_priority(frost_task_ctx_t* task, uint32_t priority) {
+
+  if(task == NULL || priority >= FROST_PRIORITY_LEVELS)
+    return frost_err_invalid_parameter;
+  else if(!task->engine->initialized)
+    return frost_err_need_initialize;
+
+  // the queued task moves to the new level
+  bool _queued = heap_is_queued(&task->sched.urgency);
+  if(_queued) prioq_delete(task->engine->scheduler.runq, &task->sched.urgency, task->priority);
+
+  task->priority = (uint8_t)priority;
+
+  // run in next pass if it cannot be queued
+  if(_queued && !frost_ok(__sched_runq(task)))
+    return __sched_queue(task, &task->engine->scheduler.ready);
+
+  return frost_err_ok;
+}
+
+frost_errcode_t frost_task_get_priority(frost_task_ctx_t* task, uint32_t* priority) {
+
+  if(task == NULL || priority == NULL)
+    return frost_err_invalid_parameter;
+
+  *priority = task->priority;
+  return frost_err_ok;
+}
+
+frost_errcode_t frost_task_suspend(uint64_t until) {
+
+  #ifdef FROST_HAS_CORO
+  frost_task_ctx_t* _ctx = __task_suspendable();
+  if(_ctx == NULL)
+    return frost_err_invalid_parameter;
+
+  if(until < _ctx->engine->scheduler.tick)
+    until = _ctx->engine->scheduler.tick;
+
+  _ctx->coro.until = until;
+  return coro_suspend();
+  #else
+  (void)until;
+  return frost_err_invalid_parameter;
+  #endif
+}
+
+frost_errcode_t frost_task_resume(frost_task_ctx_t* task) {
+
+  if(task == NULL)
+    return frost_err_invalid_parameter;
+  else if(!task->engine->initialized)
+    return frost_err_need_initialize;
+
+  // only the task waiting for its resume tick
+  if(task->sched.running || task->sched.deleted ||
+     (task->coro.ref == NULL && task->coro.line == 0))
+    return frost_err_ok;
+
+  task->coro.until = task->engine->scheduler.tick;
+
+  frost_errcode_t _result = __sched_file(task);
+  __sched_wakeup(task->engine);
+
+  return _result;
+}
+
+bool frost_task_can_suspend() {
+  return __task_suspendable() != NULL;
+}
+
+frost_errcode_t frost_yield() {
+
+  // the stackful task comes back in next pass
+  if(frost_task_can_suspend())
+    return frost_task_suspend(0);
+
+  // a worker has no engine to drive
+  if(executor_is_worker()) {
+    idle_yield();
+    return frost_err_ok;
+  }
+
+  return frost_schedule_tasks();
+}
+
 frost_errcode_t frost_sleep(size_t duration_ms) {
 
+  // a worker cannot drive the engine, run the executor tasks while sleeping
+  if(executor_is_worker())
+    return executor_sleep(duration_ms);
+
+  // the stackful task is resumed by the timer, the scheduler keeps its stack flat
+  if(frost_task_can_suspend()) {
+    uint64_t _until = __frost_time_tick(NULL) + duration_ms;
+    while(__frost_time_tick(NULL) < _until) {
+      frost_task_suspend(_until);
+    }
+
+    return frost_err_ok;
+  }
+
+  frost_engine_t* _engine = __engine_current();
   uint64_t _local_time = __frost_time_tick(NULL);
   frost_errcode_t _ret = frost_err_ok;
 
   while(!(__frost_time_tick(NULL) - _local_time >= duration_ms)) {
-    _ret = frost_schedule_tasks();
+    _ret = frost_schedule_tasks_ex(_engine);
+    __sched_idle(_engine, _local_time + duration_ms);
   }
 
   return _ret;
 }
 
+frost_errcode_t frost_get_next_deadline_ex(frost_engine_t* e, uint64_t* tick) {
+
+  if(e == NULL || tick == NULL)
+    return frost_err_invalid_parameter;
+  else if(!e->initialized)
+    return frost_err_need_initialize;
+
+  bool _found = false;
+  uint64_t _deadline = UINT64_MAX;
+
+  // the queued tasks are due
+  if(e->scheduler.runq->size != 0) {
+    _deadline = e->scheduler.tick;
+    _found = true;
+  }
+
+  if(e->scheduler.ready.size != 0) {
+    if(e->scheduler.tick < _deadline) _deadline = e->scheduler.tick;
+    _found = true;
+  }
+
+  // the submitted tasks are added in next pass
+  #ifdef FROST_HAS_ATOMICS
+  if(!mpsc_is_empty(e->scheduler.inbox)) {
+    if(e->scheduler.tick < _deadline) _deadline = e->scheduler.tick;
+    _found = true;
+  }
+  #endif
+
+  // the earliest timer
+  uint64_t _expires = 0;
+  if(frost_ok(wheel_next_expiry(e->scheduler.timers, &_expires))) {
+    if(_expires < _deadline) _deadline = _expires;
+    _found = true;
+  }
+
+  if(!_found)
+    return frost_err_eof;
+
+  *tick = _deadline;
+  return frost_err_ok;
+}
+
+frost_errcode_t frost_get_next_deadline(uint64_t* tick) {
+  return frost_get_next_deadline_ex(__engine_current(), tick);
+}
+
+frost_errcode_t frost_run_ex(frost_engine_t* e, frost_idle_t idle) {
+
+  if(e == NULL)
+    return frost_err_invalid_parameter;
+  else if(!e->initialized)
+    return frost_err_need_initialize;
+
+  frost_errcode_t _result = frost_err_ok;
+
+  e->idle.strategy = idle;
+  e->idle.running = true;
+
+  while(e->idle.running) {
+
+    if(!frost_ok(_result = frost_schedule_tasks_ex(e)))
+      break;
+
+    // nothing is due, idle until the next deadline
+    if(e->idle.running)
+      __sched_idle(e, FROST_IDLE_INFINITE);
+  }
+
+  e->idle.running = false;
+  return _result;
+}
+
+frost_errcode_t frost_run(frost_idle_t idle) {
+  return frost_run_ex(__engine_current(), idle);
+}
+
+frost_errcode_t frost_stop_ex(frost_engine_t* e) {
+
+  if(e == NULL)
+    return frost_err_invalid_parameter;
+  else if(!e->initialized)
+    return frost_err_need_initialize;
+
+  e->idle.running = false;
+  idle_wake(&e->idle.ctx);
+
+  return frost_err_ok;
+}
+
+frost_errcode_t frost_stop() {
+  return frost_stop_ex(__engine_current());
+}
+
+frost_errcode_t frost_wakeup_ex(frost_engine_t* e) {
+
+  if(e == NULL)
+    return frost_err_invalid_parameter;
+  else if(!e->initialized)
+    return frost_err_need_initialize;
+
+  idle_wake(&e->idle.ctx);
+  return frost_err_ok;
+}
+
+frost_errcode_t frost_wakeup() {
+  return frost_wakeup_ex(__engine_current());
+}
+
 uint64_t frost_get_timetick(uint64_t* tick) {
   return __frost_time_tick(tick);
 }
 
-/**
- * @brief enumerate task list
- *
- * @return frost_errcode_t if reach the end return frost_err_eof
- */
-frost_errcode_t frost_enumerate_tasks(frost_task_enum_t* e) {
+frost_errcode_t frost_enumerate_tasks_ex(frost_engine_t* engine, frost_task_enum_t* e) {
 
   #define _to_handle(x) ((frost_handle_t)(x))
-  #define _from_handle(x) ((list_node_t*)(x))
+  #define _from_handle(x) ((ilist_node_t*)(x))
 
-  if(e == NULL) {
+  if(engine == NULL || e == NULL) {
     return frost_err_invalid_parameter;
   }
 
-  list_node_t* _node = NULL;
+  ilist_node_t* _node = NULL;
   
   if(!e->__inited) {
     e->__inited = true;
 
-    if(!engine.scheduler.tasks->head) {
+    if(!engine->scheduler.tasks.head) {
       return frost_err_eof;
     }
 
-    _node = engine.scheduler.tasks->head;
+    _node = engine->scheduler.tasks.head;
     e->__next = _to_handle(_node->next);
     e->index = 0;
-    e->task = *(frost_task_ctx_t **)_node->data;
+    e->task = ilist_entry(_node, frost_task_ctx_t, ref);
+    e->miss = e->task->miss;
     return frost_err_ok;
   }
   
@@ -447,13 +1835,23 @@ frost_errcode_t frost_enumerate_tasks(frost_task_enum_t* e) {
       return frost_err_eof;
     }
 
-    _node = ((list_node_t *)e->__next);
+    _node = _from_handle(e->__next);
     e->__next = _to_handle(_node->next);
     e->index++;
-    e->task = *(frost_task_ctx_t **)_node->data;
+    e->task = ilist_entry(_node, frost_task_ctx_t, ref);
+    e->miss = e->task->miss;
     return frost_err_ok;
   }
 
   #undef _to_handle
   #undef _from_handle
 }
+
+/**
+ * @brief enumerate task list
+ *
+ * @return frost_errcode_t if reach the end return frost_err_eof
+ */
+frost_errcode_t frost_enumerate_tasks(frost_task_enum_t* e) {
+  return frost_enumerate_tasks_ex(__engine_current(), e);
+}
@@ -17,8 +17,19 @@
 
 #include "common.h"
 #include "log.h"
+#include "idle.h"
+#include "trace.h"
 #include "data/list.h"
+#include "data/ilist.h"
+#include "data/slab.h"
+#include "data/pool.h"
 #include "data/slab-rb.h"
+#include "data/wheel.h"
+#include "data/heap.h"
+#include "data/prioq.h"
+#include "data/hist.h"
+#include "data/mpsc.h"
+#include "data/aring.h"
 
 #define T frost_handle_t
 typedef void (* frost_callback_t)();
@@ -47,12 +58,73 @@ typedef void (* frost_callback_arg15_t)(T,T,T,T,T,T,T,T,T,T,T,T,T,T,T);
 #endif
 
 /**
- * @brief Channel Ringbuff size
+ * @brief locals storage size of a stackless task, see @ref FROST_CO_BEGIN()
+ */
+#ifndef FROST_CO_FRAME_SIZE
+  #define FROST_CO_FRAME_SIZE 32
+#endif
+
+/**
+ * @brief objects per slab chunk of the task contexts, awaiters and scheduler list nodes
+ */
+#ifndef FROST_SLAB_CHUNK_SIZE
+  #define FROST_SLAB_CHUNK_SIZE 32
+#endif
+
+/**
+ * @brief take one clock sample per schedule pass plus one after every task callback,
+ * a task starts at the time the previous callback returned. set 0 to sample before every task
+ */
+#ifndef FROST_TIME_SNAPSHOT
+  #define FROST_TIME_SNAPSHOT 1
+#endif
+
+/**
+ * @brief Channel Ringbuff size, the default slots of a channel. rounded up to power of two
  */
 #ifndef FROST_CHAN_RINGBUFF_SIZE
   #define FROST_CHAN_RINGBUFF_SIZE 16
 #endif
 
+/**
+ * @brief the biggest size class of channel pack pool in bytes, the pack header included.
+ * the larger packs are allocated by malloc
+ */
+#ifndef FROST_CHAN_POOL_MAX_SIZE
+  #define FROST_CHAN_POOL_MAX_SIZE 1024
+#endif
+
+/**
+ * @brief max cached packs per size class of channel pack pool, set 0 to disable the cache
+ */
+#ifndef FROST_CHAN_POOL_CAP
+  #define FROST_CHAN_POOL_CAP 32
+#endif
+
+/**
+ * @brief packs retained on the stack at a time by @ref frost_chan_write_many_ex()
+ */
+#ifndef FROST_CHAN_BATCH_SIZE
+  #define FROST_CHAN_BATCH_SIZE 32
+#endif
+
+/**
+ * @brief the priority of new tasks, 0 to FROST_PRIORITY_LEVELS - 1.
+ * the due task of higher priority runs first in a pass
+ */
+#define FROST_PRIORITY_LEVELS PRIOQ_LEVELS
+#ifndef FROST_PRIORITY_DEFAULT
+  #define FROST_PRIORITY_DEFAULT 16
+#endif
+
+/**
+ * @brief the EDF utilization bound of realtime task admission in ppm,
+ * lower it to keep headroom for the other tasks
+ */
+#ifndef FROST_EDF_BOUND
+  #define FROST_EDF_BOUND 1000000
+#endif
+
 #ifdef _MSC_VER
   #define TAG __FUNCTION__
 #elif __GNUC__
@@ -75,15 +147,37 @@ typedef enum {
 } frost_chanctl_t;
 
 typedef struct _frost_awaiter_t {
-  bool is_finished;
-  frost_handle_t result;
+  FROST_ATOMIC(bool) is_finished; /* may be set by an executor worker */
+  frost_handle_t result; /* written only by the side that claimed the awaiter */
   frost_errcode_t status;
   uint64_t timeout;
+  bool is_bound; /* owned by a task, published by the scheduler after the task returns */
+  bool is_resolved; /* the bound task has set the result */
+  bool is_remote; /* waited by a foreign thread, which does not drive the engine */
+  FROST_ATOMIC(bool) is_claimed; /* the result is being published, by the task or the timed out waiter */
+  FROST_ATOMIC(int) refs; /* the caller, and the bound task until it settles */
+  struct {
+    frost_handle_t result;
+    frost_errcode_t status;
+  } resolved; /* set by the bound task, published when it settles */
+  slab_ctx_t* slab; /* the slab owns this awaiter, NULL if allocated by malloc */
 } frost_awaiter_t;
 
+typedef enum {
+  frost_chanmode_local = 0, /* written and read on the engine thread */
+  frost_chanmode_spsc = 1, /* written by one thread at a time, from any engine */
+  frost_chanmode_mpsc = 2, /* written by any threads and engines */
+} frost_chanmode_t;
+
 typedef struct _frost_chan_t {
   rb_header_t* header;
-  int notify_cnt;
+  FROST_ATOMIC(int) notify_cnt; /* may be increased by the other threads */
+  frost_chanmode_t mode;
+  #ifdef FROST_HAS_ATOMICS
+  aring_ctx_t* ring; /* the packs written across threads, NULL for local channel */
+  #endif
+  ilist_ctx_t blocked; /* ilist<frost_task_ctx_t> by chan.wait_link, the writers waiting for a free slot */
+  FROST_ATOMIC(size_t) dropped; /* the packs not written since the channel was full */
 } frost_chan_t;
 
 typedef struct _frost_tls_t {
@@ -95,18 +189,75 @@ typedef struct {
   frost_handle_t argv[16];
 } frost_args_t;
 
+typedef struct _frost_task_miss_t {
+  uint32_t count; /* deadline misses */
+  uint32_t consecutive; /* misses in a row, an in-time run resets it */
+  uint64_t worst; /* the worst lateness in milliseconds */
+  uint64_t average; /* the average lateness of the misses in milliseconds */
+  uint64_t total; /* the total lateness in milliseconds */
+} frost_task_miss_t;
+
+typedef struct _frost_task_profile_t {
+  uint64_t count; /* recorded runs */
+  uint64_t p50; /* execution time quantiles in nanoseconds */
+  uint64_t p99;
+  uint64_t p999;
+  uint64_t max;
+} frost_task_profile_t;
+
+struct _frost_engine_t;
+
 typedef struct _frost_ctx_t {
-  list_node_t* ref;
-  const char* name;
-  frost_args_t args;
-  frost_tls_t* tls;
-  frost_awaiter_t* awaiter;
+
+  // the fields read by the scheduler every run come first,
+  // they share the leading cache lines of the context
+  struct _frost_engine_t* engine; /* the engine owns this task */
   frost_callback_t callback;
   frost_flag_t flags;
   uint32_t interval;
+  uint32_t deadline; /* relative deadline in milliseconds, 0 for the interval. the run queue orders by tick + deadline */
+  uint32_t utilization; /* the admitted EDF utilization in ppm, 0 if not a realtime task */
   uint64_t tick;
   uint64_t exec_time;
   int64_t score;
+  bool refill;
+  bool pooled; /* allocated from the slab of engine */
+  uint8_t priority; /* the level in run queue, the higher runs first */
+
+  struct {
+    ilist_node_t link; /* the link in ready list, not linked if not queued */
+    wheel_node_t timer;
+    heap_node_t urgency;
+    #ifdef FROST_HAS_ATOMICS
+    mpsc_node_t inbox;
+    mpsc_node_t wake;
+    FROST_ATOMIC(int) wake_queued; /* the wake node is in the inbox */
+    #endif
+    struct _frost_ctx_t* reap; /* the next deleted task to free after the pass */
+    bool running;
+    bool deleted;
+  } sched;
+
+  struct {
+    struct _coro_t* ref; /* the coroutine of stackful task, NULL if not started or returned */
+    uint64_t until; /* the tick to resume the suspended task */
+    uint32_t line; /* the resume point of stackless task, 0 to start over */
+    bool enabled; /* stackful task */
+    union {
+      uint8_t bytes[FROST_CO_FRAME_SIZE];
+      uint64_t __align;
+      void* __align_ptr;
+    } frame; /* the locals of stackless task */
+  } coro;
+
+  // the cold fields, touched by the task itself or on creation and deletion
+  ilist_node_t ref; /* the link in task registry, not linked for the executor task */
+  const char* name;
+  frost_args_t args;
+  frost_tls_t* tls;
+  frost_awaiter_t* awaiter;
+  frost_task_miss_t miss; /* the deadline misses of periodic task */
+  hist_ctx_t* hist; /* the callback durations in nanoseconds, created on demand when profiling */
 
   #ifdef FROST_DEBUG
   uint64_t fire;
@@ -115,21 +266,54 @@ typedef struct _frost_ctx_t {
   struct {
     frost_chan_t* ref;
     list_ctx_t* bind; /* list<frost_chan_t*> */
+    frost_chan_t* wait; /* the full channel waiting to write, NULL if not waiting */
+    ilist_node_t wait_link; /* the link in its blocked list */
   } chan;
-
-  bool refill;
 } frost_task_ctx_t;
 
-typedef struct {
+/**
+ * @brief called after a periodic task finishes past its deadline, the
+ * deadline is the task tick plus its relative deadline, or its interval if not set
+ *
+ * @param task the late task
+ * @param lateness how late the task finished in milliseconds
+ */
+typedef void (* frost_miss_callback_t)(frost_task_ctx_t* task, uint64_t lateness);
+
+typedef struct _frost_engine_t {
   bool initialized;
   struct {
-    list_ctx_t* tasks;
+    ilist_ctx_t tasks; /* ilist<frost_task_ctx_t> by ref */
+    ilist_ctx_t ready; /* ilist<frost_task_ctx_t> by sched.link, run in next pass */
+    prioq_ctx_t* runq; /* prioq<frost_task_ctx_t*>, run in current pass by priority, then urgency */
+    wheel_ctx_t* timers;
+    #ifdef FROST_HAS_ATOMICS
+    mpsc_ctx_t* inbox; /* mpsc<frost_task_ctx_t*>, submitted or woken by the other threads */
+    #endif
     frost_task_ctx_t* context;
+    frost_task_ctx_t* reap; /* the deleted tasks, freed after the outermost pass */
+    frost_miss_callback_t on_miss; /* NULL if not set */
+    uint32_t depth; /* nested passes */
+    uint64_t utilization; /* the admitted EDF utilization of realtime tasks in ppm */
     uint64_t tick;
     bool is_dirty;
     bool is_realtime;
+    bool profiling; /* record the callback durations of tasks */
     int32_t last_score;
   } scheduler;
+  struct {
+    frost_idle_ctx_t ctx;
+    frost_idle_t strategy;
+    FROST_ATOMIC(bool) running; /* may be stopped by the other threads */
+  } idle;
+  frost_trace_ctx_t trace; /* the scheduler events, owner thread only */
+  struct _frost_executor_t* executor; /* run one-shot tasks on workers, NULL if not started */
+  struct _coro_pool_t* coro_pool; /* the stacks of stackful tasks, created on demand */
+  struct {
+    slab_ctx_t* tasks; /* slab<frost_task_ctx_t> */
+    slab_ctx_t* awaiters; /* slab<frost_awaiter_t> */
+    pool_ctx_t* packs; /* the channel packs written by the tasks of this engine */
+  } pool;
 } frost_engine_t;
 
 /**
@@ -147,7 +331,8 @@ frost_errcode_t frost_init();
 bool frost_is_initialized();
 
 /**
- * @brief engine uninitialization
+ * @brief engine uninitialization, the task contexts, awaiters and channel packs
+ * allocated by the engine are freed, destroy the awaiters and read the packs before
  *
  * @return frost_errcode_t if success return ok
  */
@@ -161,13 +346,43 @@ frost_errcode_t frost_uninit();
 bool frost_is_initialized();
 
 /**
- * @brief get engine instance
+ * @brief get engine instance, the engine scheduling on current thread
+ * or the default engine
  *
  * @param instance pointer to storage engine pointer
  * @return frost_errcode_t if success return ok
  */
 frost_errcode_t frost_get_engine(frost_engine_t** instance);
 
+/**
+ * @brief create an independent engine instance. the engine has its own
+ * tasks, timers and idle context, and can be driven by another thread.
+ * the global api operates the engine scheduling on current thread,
+ * or the default engine of @ref frost_init()
+ *
+ * @param instance pointer to storage engine pointer
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t frost_engine_create(frost_engine_t** instance);
+
+/**
+ * @brief destroy an engine instance created by @ref frost_engine_create(),
+ * the awaiters and channel packs of its tasks must be destroyed before
+ *
+ * @param instance engine instance
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t frost_engine_destroy(frost_engine_t* instance);
+
+/**
+ * @brief bind current thread to an engine, the global api of this thread
+ * operates the engine. the binding is overridden while another engine is scheduling
+ *
+ * @param e engine instance, NULL to use the default engine
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t frost_engine_attach(frost_engine_t* e);
+
 /**
  * @brief process tasks
  *
@@ -175,6 +390,14 @@ frost_errcode_t frost_get_engine(frost_engine_t** instance);
  */
 frost_errcode_t frost_schedule_tasks();
 
+/**
+ * @brief process tasks of an engine
+ *
+ * @param e engine instance
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t frost_schedule_tasks_ex(frost_engine_t* e);
+
 /**
  * @brief get current context
  *
@@ -201,6 +424,57 @@ frost_awaiter_t* frost_task_run(void* func);
 */
 frost_awaiter_t* frost_task_run_ex(void* func, uint32_t argc, ...);
 
+/**
+ * @brief run a task async on an engine
+ *
+ * @param e engine instance
+ * @param func task callback
+ * @param argc argument count for task
+ * @param ... arguments
+ * @return frost_awaiter_t* return an awaiter, please call @ref awaiter_destroy() to free it after task done
+*/
+frost_awaiter_t* frost_task_spawn_ex(frost_engine_t* e, void* func, uint32_t argc, ...);
+
+/**
+ * @brief run a stackful task async, the task runs on its own stack taken from a pool.
+ * await, sleep and yield in the task suspend it, instead of scheduling the
+ * other tasks recursively on top of it
+ *
+ * @param func task callback
+ * @return frost_awaiter_t* return an awaiter, please call @ref awaiter_destroy() to free it after task done
+ */
+frost_awaiter_t* frost_task_run_stackful(void* func);
+
+/**
+ * @brief run a stackful task async
+ *
+ * @param func task callback
+ * @param argc argument count for task
+ * @param ... arguments
+ * @return frost_awaiter_t* return an awaiter, please call @ref awaiter_destroy() to free it after task done
+ */
+frost_awaiter_t* frost_task_run_stackful_ex(void* func, uint32_t argc, ...);
+
+/**
+ * @brief run a stackful task async on an engine, it always runs on the engine
+ * thread even if the executor is started
+ *
+ * @param e engine instance
+ * @param func task callback
+ * @param argc argument count for task
+ * @param ... arguments
+ * @return frost_awaiter_t* return an awaiter, please call @ref awaiter_destroy() to free it after task done
+ */
+frost_awaiter_t* frost_task_spawn_stackful_ex(frost_engine_t* e, void* func, uint32_t argc, ...);
+
+/**
+ * @brief make a task stackful from its next run, e.g. an interval task
+ *
+ * @param task pointer to task context
+ * @return frost_errcode_t if the platform has no context switch return frost_err_fatal_error
+ */
+frost_errcode_t frost_task_set_stackful(frost_task_ctx_t* task);
+
 /**
  * @brief set task interval
  *
@@ -212,13 +486,229 @@ frost_awaiter_t* frost_task_run_ex(void* func, uint32_t argc, ...);
 frost_errcode_t frost_task_interval(uint32_t interval, void* func, frost_task_ctx_t** task);
 
 /**
- * @brief delete a task
+ * @brief set task interval on an engine
+ *
+ * @param e engine instance
+ * @param interval interval in milliseconds
+ * @param func task callback
+ * @param task pointer to task context
+ * @return frost_errcode_t if success return ok
+*/
+frost_errcode_t frost_task_interval_ex(frost_engine_t* e, uint32_t interval, void* func, frost_task_ctx_t** task);
+
+/**
+ * @brief create a periodic realtime task, the due tasks of a priority run by their
+ * absolute deadlines (EDF), the other tasks have their intervals as deadlines. the task is admitted only if the total EDF utilization
+ * of realtime tasks stays within FROST_EDF_BOUND, a task uses its budget over
+ * the shorter of its deadline and period
+ *
+ * @param period period in milliseconds
+ * @param deadline relative deadline in milliseconds, 0 for the period
+ * @param budget worst-case execution time in microseconds
+ * @param func task callback
+ * @param task pointer to task context
+ * @return frost_errcode_t if the task set would be overloaded return frost_err_overload
+ */
+frost_errcode_t frost_task_realtime(uint32_t period, uint32_t deadline, uint32_t budget, void* func, frost_task_ctx_t** task);
+
+/**
+ * @brief create a periodic realtime task on an engine
+ *
+ * @param e engine instance
+ * @param period period in milliseconds
+ * @param deadline relative deadline in milliseconds, 0 for the period
+ * @param budget worst-case execution time in microseconds
+ * @param func task callback
+ * @param task pointer to task context
+ * @return frost_errcode_t if the task set would be overloaded return frost_err_overload
+ */
+frost_errcode_t frost_task_realtime_ex(frost_engine_t* e, uint32_t period, uint32_t deadline,
+  uint32_t budget, void* func, frost_task_ctx_t** task);
+
+/**
+ * @brief get the EDF utilization admitted by the realtime tasks, the deleted tasks give back theirs
+ *
+ * @param e engine instance
+ * @param utilization return the utilization in ppm
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t frost_get_utilization_ex(frost_engine_t* e, uint64_t* utilization);
+frost_errcode_t frost_get_utilization(uint64_t* utilization);
+
+/**
+ * @brief set the callback of deadline misses, the statistics are kept in task miss regardless
+ *
+ * @param callback called after a task misses its deadline, NULL to unset
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t frost_set_miss_callback(frost_miss_callback_t callback);
+
+/**
+ * @brief set the callback of deadline misses of an engine
+ *
+ * @param e engine instance
+ * @param callback called after a task misses its deadline, NULL to unset
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t frost_set_miss_callback_ex(frost_engine_t* e, frost_miss_callback_t callback);
+
+/**
+ * @brief turn the execution time profiling on or off, the duration of every task
+ * callback is recorded into a log-bucketed histogram of the task in nanoseconds.
+ * a resumed stackful or stackless task records every slice it runs
+ *
+ * @param enabled start recording if true, the recorded values are kept when stopped
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t frost_set_profiling(bool enabled);
+
+/**
+ * @brief turn the execution time profiling of an engine on or off
+ *
+ * @param e engine instance
+ * @param enabled start recording if true, the recorded values are kept when stopped
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t frost_set_profiling_ex(frost_engine_t* e, bool enabled);
+
+/**
+ * @brief get the execution time quantiles of a task, within the relative
+ * error of 1 / HIST_SUB_COUNT
+ *
+ * @param task task context
+ * @param profile return the quantiles in nanoseconds
+ * @return frost_errcode_t if nothing is recorded return frost_err_eof
+ */
+frost_errcode_t frost_task_get_profile(frost_task_ctx_t* task, frost_task_profile_t* profile);
+
+/**
+ * @brief clear the recorded execution time of a task
+ *
+ * @param task task context
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t frost_task_reset_profile(frost_task_ctx_t* task);
+
+/**
+ * @brief start recording the scheduler events into a fixed-size ring, the oldest
+ * events are overwritten when full. the recorded events are cleared
+ *
+ * @param capacity events kept, 0 for FROST_TRACE_SIZE
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t frost_trace_start(size_t capacity);
+
+/**
+ * @brief start recording the scheduler events of an engine
+ *
+ * @param e engine instance
+ * @param capacity events kept, 0 for FROST_TRACE_SIZE
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t frost_trace_start_ex(frost_engine_t* e, size_t capacity);
+
+/**
+ * @brief stop recording the scheduler events, the recorded events are kept for export
+ *
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t frost_trace_stop();
+frost_errcode_t frost_trace_stop_ex(frost_engine_t* e);
+
+/**
+ * @brief export the recorded events as Chrome trace JSON, it can be opened by Perfetto.
+ * the task slices are named by their callback addresses
+ *
+ * @param writer called with every piece of the text in order
+ * @param user passed to the writer
+ * @return frost_errcode_t if the trace is never started return frost_err_need_initialize
+ */
+frost_errcode_t frost_trace_export(frost_trace_writer_t writer, void* user);
+
+/**
+ * @brief export the recorded events of an engine as Chrome trace JSON
+ *
+ * @param e engine instance
+ * @param writer called with every piece of the text in order
+ * @param user passed to the writer
+ * @return frost_errcode_t if the trace is never started return frost_err_need_initialize
+ */
+frost_errcode_t frost_trace_export_ex(frost_engine_t* e, frost_trace_writer_t writer, void* user);
+
+/**
+ * @brief submit a task from any thread, the task is added at the start of next pass.
+ * the awaiter can be waited on the submitting thread, it does not drive the engine
+ *
+ * @param func task callback
+ * @return frost_awaiter_t* return an awaiter, please call @ref awaiter_destroy() to free it after task done
+ */
+frost_awaiter_t* frost_task_submit(void* func);
+
+/**
+ * @brief submit a task to an engine from any thread, lock-free
+ *
+ * @param e engine instance
+ * @param func task callback
+ * @param argc argument count for task
+ * @param ... arguments
+ * @return frost_awaiter_t* return an awaiter, please call @ref awaiter_destroy() to free it after task done
+ */
+frost_awaiter_t* frost_task_submit_ex(frost_engine_t* e, void* func, uint32_t argc, ...);
+
+/**
+ * @brief submit an interval task to an engine from any thread, lock-free
+ *
+ * @param e engine instance
+ * @param interval interval in milliseconds
+ * @param func task callback
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t frost_task_submit_interval_ex(frost_engine_t* e, uint32_t interval, void* func);
+
+/**
+ * @brief delete a task, its context is freed after the current schedule pass
  *
  * @param task pointer to task context
  * @return frost_errcode_t if success return ok
 */
 frost_errcode_t frost_task_delete(frost_task_ctx_t* task);
 
+/**
+ * @brief free the context of a task not in the engine registry,
+ * e.g. the one-shot task retired by the executor. safe to call from any thread
+ *
+ * @param task pointer to task context
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t frost_task_release(frost_task_ctx_t* task);
+
+/**
+ * @brief hand a sleeping stackless task retired by the executor back to its engine,
+ * it waits in the timer wheel and resumes on the engine thread. safe to call from any thread
+ *
+ * @param task pointer to task context
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t frost_task_defer(frost_task_ctx_t* task);
+
+/**
+ * @brief notify a task that its channel has new packs, a parked task
+ * waiting for channel write will be woken up and run in next pass
+ *
+ * @param task pointer to task context
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t frost_task_notify(frost_task_ctx_t* task);
+
+/**
+ * @brief notify a task from any thread or engine, lock-free.
+ * the task is notified by its engine at the start of next pass
+ *
+ * @param task pointer to task context
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t frost_task_notify_remote(frost_task_ctx_t* task);
+
 /**
  * @brief set task flag
  *
@@ -238,14 +728,132 @@ frost_errcode_t frost_task_set_flag(frost_task_ctx_t* task, frost_flag_t flag);
 frost_errcode_t frost_task_get_flag(frost_task_ctx_t* task, frost_flag_t* flag);
 
 /**
- * @brief sleep (ms). this function can grab the schedule rights from the main thread,
+ * @brief set task priority. the due tasks run from the highest priority,
+ * and by urgency in the same priority. it takes effect in current pass
+ *
+ * @param task pointer to task context
+ * @param priority 0 to FROST_PRIORITY_LEVELS - 1, FROST_PRIORITY_DEFAULT for new tasks
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t frost_task_set_priority(frost_task_ctx_t* task, uint32_t priority);
+
+/**
+ * @brief get task priority
+ *
+ * @param task pointer to task context
+ * @param priority return the priority
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t frost_task_get_priority(frost_task_ctx_t* task, uint32_t* priority);
+
+/**
+ * @brief suspend current stackful task until the tick, the scheduler runs the other tasks
+ * meanwhile. the tick earlier than current pass resumes the task in next pass
+ *
+ * @param until the tick to resume
+ * @return frost_errcode_t if current task is not stackful return frost_err_invalid_parameter
+ */
+frost_errcode_t frost_task_suspend(uint64_t until);
+
+/**
+ * @brief resume a suspended stackful or stackless task in next pass, before the tick it asked for
+ *
+ * @param task pointer to task context
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t frost_task_resume(frost_task_ctx_t* task);
+
+/**
+ * @brief can current task be suspended by @ref frost_task_suspend()
+ *
+ * @return bool running a stackful task return true
+ */
+bool frost_task_can_suspend();
+
+/**
+ * @brief give up the cpu. a stackful task suspends until next pass,
+ * otherwise run a schedule pass on top of current task
+ *
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t frost_yield();
+
+/**
+ * @brief sleep (ms). a stackful task suspends until the time is up.
+ * otherwise this function can grab the schedule rights from the main thread,
  * temporarily schedule another tasks and wait for timeout.
+ * the scheduler idles by the strategy of @ref frost_run() when nothing is due.
  *
  * @param duration_ms duration in millisecond
  * @return frost_errcode_t if success return ok
  */
 frost_errcode_t frost_sleep(size_t duration_ms);
 
+/**
+ * @brief get the earliest deadline of all pending tasks
+ *
+ * @param tick receive the deadline tick, a due task returns current tick
+ * @return frost_errcode_t if no task is pending return frost_err_eof
+ */
+frost_errcode_t frost_get_next_deadline(uint64_t* tick);
+
+/**
+ * @brief get the earliest deadline of all pending tasks of an engine
+ *
+ * @param e engine instance
+ * @param tick receive the deadline tick, a due task returns current tick
+ * @return frost_errcode_t if no task is pending return frost_err_eof
+ */
+frost_errcode_t frost_get_next_deadline_ex(frost_engine_t* e, uint64_t* tick);
+
+/**
+ * @brief run the scheduler until @ref frost_stop() is called.
+ * when no task is due, the scheduler idles by the given strategy
+ *
+ * @param idle idle strategy
+ * @return frost_errcode_t if stopped return ok
+ */
+frost_errcode_t frost_run(frost_idle_t idle);
+
+/**
+ * @brief run an engine until @ref frost_stop_ex() is called
+ *
+ * @param e engine instance
+ * @param idle idle strategy
+ * @return frost_errcode_t if stopped return ok
+ */
+frost_errcode_t frost_run_ex(frost_engine_t* e, frost_idle_t idle);
+
+/**
+ * @brief stop the scheduler started by @ref frost_run()
+ *
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t frost_stop();
+
+/**
+ * @brief stop an engine started by @ref frost_run_ex(), it's safe to call from other threads
+ *
+ * @param e engine instance
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t frost_stop_ex(frost_engine_t* e);
+
+/**
+ * @brief wake up the parked scheduler, it's safe to call from other threads
+ *
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t frost_wakeup();
+
+/**
+ * @brief wake up a parked engine, it's safe to call from other threads
+ *
+ * @param e engine instance
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t frost_wakeup_ex(frost_engine_t* e);
+
 /**
  * @brief get timetick
  *
@@ -259,13 +867,23 @@ typedef struct _frost_task_enum_t {
   frost_handle_t __next;
   size_t index;
   frost_task_ctx_t* task;
+  frost_task_miss_t miss; /* the deadline misses of current task */
 } frost_task_enum_t;
 
 /**
- * @brief enumerate task list
+ * @brief enumerate task list, the deadline misses are snapshot into the enumerator
  *
  * @return frost_errcode_t if reach the end return frost_err_eof
  */
 frost_errcode_t frost_enumerate_tasks(frost_task_enum_t* e);
 
+/**
+ * @brief enumerate task list of an engine
+ *
+ * @param engine engine instance
+ * @param e enumerator
+ * @return frost_errcode_t if reach the end return frost_err_eof
+ */
+frost_errcode_t frost_enumerate_tasks_ex(frost_engine_t* engine, frost_task_enum_t* e);
+
 #endif /* _FROST_ENGINE_H */
@@ -0,0 +1,457 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#include <stdlib.h>
+
+#include "engine.h"
+#include "executor.h"
+#include "await.h"
+#include "tls.h"
+#include "callback.h"
+
+#if defined(FROST_HAS_ATOMICS) && (defined(__unix__) || defined(__APPLE__))
+  #define FROST_EXECUTOR_PTHREAD
+  #include <pthread.h>
+  #include <unistd.h>
+  #include <stdatomic.h>
+  #include "data/deque.h"
+#endif
+
+#ifdef FROST_EXECUTOR_PTHREAD
+
+typedef struct _frost_worker_t {
+  struct _frost_executor_t* executor;
+  deque_ctx_t* deque;
+  uint32_t index;
+  uint32_t seed;
+  pthread_t thread;
+} frost_worker_t;
+
+typedef struct _frost_executor_t {
+  frost_engine_t* engine;
+  frost_worker_t* workers;
+  uint32_t size;
+  uint32_t started;
+  deque_ctx_t* injector; /* tasks submitted by the other threads */
+  pthread_mutex_t lock; /* injector push and sleep */
+  pthread_cond_t cond;
+  atomic_bool running;
+  atomic_size_t pending; /* queued tasks of all deques */
+  atomic_uint sleepers;
+} frost_executor_t;
+
+// the worker and the task running on this thread
+static FROST_THREAD_LOCAL frost_worker_t* __worker = NULL;
+static FROST_THREAD_LOCAL frost_task_ctx_t* __worker_context = NULL;
+
+/**
+ * MARK: __executor_retire
+ * @brief clean up a finished task, the one-shot task is not in the engine registry
+ */
+static void __executor_retire(frost_task_ctx_t* ctx) {
+
+  // the caller may destroy the awaiter right after, don't touch it anymore
+  if(ctx->awaiter) {
+    awaiter_settle(ctx->awaiter);
+  }
+
+  if(ctx->tls) {
+    frost_log(TAG, "destroying a task that has not destroyed tls storage yet, "
+                   "this may cause a memory leak");
+    frost_tls_destroy_ex(ctx);
+  }
+
+  if(ctx->chan.ref || ctx->chan.bind) {
+    frost_log(TAG, "task '%s'[%p] on executor uses channel, this is not supported "
+                   "and the channel is leaked", ctx->name, ctx);
+  }
+
+  frost_task_release(ctx);
+}
+
+/**
+ * MARK: __executor_take
+ * @brief take a task, from own deque first, then the injector, then steal from the others
+ */
+static frost_task_ctx_t* __executor_take(frost_executor_t* executor, frost_worker_t* worker) {
+
+  void* _item = NULL;
+
+  if(worker != NULL && frost_ok(deque_pop(worker->deque, &_item)))
+    return _item;
+
+  if(frost_ok(deque_steal(executor->injector, &_item)))
+    return _item;
+
+  // start from a random victim to spread the thieves
+  uint32_t _start = 0;
+  if(worker != NULL) {
+    worker->seed ^= worker->seed << 13;
+    worker->seed ^= worker->seed >> 17;
+    worker->seed ^= worker->seed << 5;
+    _start = worker->seed % executor->size;
+  }
+
+  for(uint32_t i = 0; i < executor->size; ++i) {
+    frost_worker_t* _victim = &executor->workers[(_start + i) % executor->size];
+    if(_victim == worker) continue;
+    if(frost_ok(deque_steal(_victim->deque, &_item)))
+      return _item;
+  }
+
+  return NULL;
+}
+
+/**
+ * MARK: __executor_run
+ * @brief run a task on current thread
+ */
+static void __executor_run(frost_executor_t* executor, frost_task_ctx_t* ctx) {
+
+  atomic_fetch_sub(&executor->pending, 1);
+
+  #ifdef FROST_DEBUG
+  ctx->fire++;
+  #endif /* FROST_DEBUG */
+
+  frost_task_ctx_t* _oldctx = __worker_context; {
+    __worker_context = ctx;
+    ctx->sched.running = true;
+    __invoke_task_callback(ctx);
+    ctx->sched.running = false;
+    __worker_context = _oldctx;
+  }
+
+  // the stackless task has suspended, run it again later.
+  // a sleeping one waits in the timer wheel of engine instead of spinning here
+  if(ctx->coro.line != 0) {
+    if(ctx->coro.until > frost_get_timetick(NULL) && frost_ok(frost_task_defer(ctx)))
+      return;
+    if(frost_ok(executor_submit(executor, ctx)))
+      return;
+  }
+
+  __executor_retire(ctx);
+}
+
+/**
+ * MARK: __executor_help
+ * @brief run one task on current worker
+ *
+ * @return run a task return true
+ */
+static bool __executor_help() {
+
+  frost_task_ctx_t* _ctx = __executor_take(__worker->executor, __worker); {
+    if(_ctx == NULL) return false;
+  }
+
+  __executor_run(__worker->executor, _ctx);
+  return true;
+}
+
+/**
+ * MARK: __executor_worker_main
+ * @brief the worker thread
+ */
+static void* __executor_worker_main(void* arg) {
+
+  frost_worker_t* _worker = (frost_worker_t *)arg;
+  frost_executor_t* _executor = _worker->executor;
+
+  __worker = _worker;
+  frost_engine_attach(_executor->engine);
+
+  uint32_t _idle = 0;
+  while(atomic_load(&_executor->running)) {
+
+    frost_task_ctx_t* _ctx = __executor_take(_executor, _worker);
+    if(_ctx != NULL) {
+      __executor_run(_executor, _ctx);
+      _idle = 0;
+      continue;
+    }
+
+    if(++_idle < FROST_EXECUTOR_SPIN) {
+      idle_yield();
+      continue;
+    }
+
+    // nothing to steal, sleep until a task is submitted
+    pthread_mutex_lock(&_executor->lock); {
+      atomic_fetch_add(&_executor->sleepers, 1);
+      while(atomic_load(&_executor->pending) == 0 && atomic_load(&_executor->running)) {
+        pthread_cond_wait(&_executor->cond, &_executor->lock);
+      }
+      atomic_fetch_sub(&_executor->sleepers, 1);
+    }
+    pthread_mutex_unlock(&_executor->lock);
+
+    _idle = 0;
+  }
+
+  frost_engine_attach(NULL);
+  __worker = NULL;
+
+  return NULL;
+}
+
+/**
+ * MARK: __executor_destroy
+ * @brief cancel the queued tasks, and free the executor. the workers must be joined
+ */
+static void __executor_destroy(frost_executor_t* executor) {
+
+  frost_task_ctx_t* _ctx = NULL;
+  while((_ctx = __executor_take(executor, NULL)) != NULL) {
+    __executor_retire(_ctx);
+  }
+
+  for(uint32_t i = 0; i < executor->size; ++i) {
+    if(executor->workers[i].deque)
+      deque_destroy(executor->workers[i].deque);
+  }
+
+  if(executor->injector)
+    deque_destroy(executor->injector);
+
+  pthread_cond_destroy(&executor->cond);
+  pthread_mutex_destroy(&executor->lock);
+
+  free(executor->workers);
+  free(executor);
+}
+
+/**
+ * MARK: __executor_join
+ * @brief stop and join the started workers
+ */
+static void __executor_join(frost_executor_t* executor) {
+
+  pthread_mutex_lock(&executor->lock); {
+    atomic_store(&executor->running, false);
+    pthread_cond_broadcast(&executor->cond);
+  }
+  pthread_mutex_unlock(&executor->lock);
+
+  for(uint32_t i = 0; i < executor->started; ++i) {
+    pthread_join(executor->workers[i].thread, NULL);
+  }
+
+  executor->started = 0;
+}
+
+frost_errcode_t frost_executor_start(frost_engine_t* e, uint32_t workers) {
+
+  if(e == NULL)
+    return frost_err_invalid_parameter;
+  else if(!e->initialized)
+    return frost_err_need_initialize;
+  else if(e->executor != NULL)
+    return frost_err_invalid_parameter;
+
+  if(workers == 0) {
+    long _cpus = sysconf(_SC_NPROCESSORS_ONLN);
+    workers = _cpus > 0 ? (uint32_t)_cpus : 1;
+  }
+
+  frost_executor_t* _executor = malloc(sizeof(frost_executor_t)); {
+    if(_executor == NULL) return frost_err_out_of_memory;
+    memset(_executor, 0, sizeof(frost_executor_t));
+  }
+
+  _executor->engine = e;
+  _executor->size = workers;
+  atomic_init(&_executor->running, true);
+  atomic_init(&_executor->pending, 0);
+  atomic_init(&_executor->sleepers, 0);
+  pthread_mutex_init(&_executor->lock, NULL);
+  pthread_cond_init(&_executor->cond, NULL);
+
+  // create the deques
+  frost_errcode_t _result = frost_err_ok;
+  if((_executor->workers = calloc(workers, sizeof(frost_worker_t))) == NULL) {
+    _result = frost_err_out_of_memory;
+  }
+
+  else if(!frost_ok(_result = deque_create(FROST_EXECUTOR_DEQUE_SIZE, &_executor->injector))) {
+  }
+
+  else {
+    for(uint32_t i = 0; i < workers; ++i) {
+      frost_worker_t* _worker = &_executor->workers[i];
+      _worker->executor = _executor;
+      _worker->index = i;
+      _worker->seed = 0x9e3779b9u * (i + 1);
+      if(!frost_ok(_result = deque_create(FROST_EXECUTOR_DEQUE_SIZE, &_worker->deque)))
+        break;
+    }
+  }
+
+  if(!frost_ok(_result)) {
+    frost_log(TAG, "go to failure procedure");
+    if(_executor->workers == NULL) _executor->size = 0;
+    __executor_destroy(_executor);
+    return _result;
+  }
+
+  // start the workers
+  for(uint32_t i = 0; i < workers; ++i) {
+    if(pthread_create(&_executor->workers[i].thread, NULL,
+       __executor_worker_main, &_executor->workers[i]) != 0) {
+      frost_log(TAG, "cannot create worker %u, go to failure procedure", i);
+      __executor_join(_executor);
+      __executor_destroy(_executor);
+      return frost_err_fatal_error;
+    }
+    _executor->started++;
+  }
+
+  e->executor = _executor;
+  frost_log(TAG, "engine[%p] executor started with %u workers", e, workers);
+
+  return frost_err_ok;
+}
+
+frost_errcode_t frost_executor_stop(frost_engine_t* e) {
+
+  if(e == NULL)
+    return frost_err_invalid_parameter;
+  else if(e->executor == NULL)
+    return frost_err_ok;
+
+  // a worker cannot join itself
+  if(__worker != NULL)
+    return frost_err_invalid_parameter;
+
+  frost_executor_t* _executor = e->executor;
+  e->executor = NULL;
+
+  __executor_join(_executor);
+  __executor_destroy(_executor);
+
+  frost_log(TAG, "engine[%p] executor stopped", e);
+  return frost_err_ok;
+}
+
+frost_errcode_t executor_submit(frost_executor_t* executor, frost_task_ctx_t* ctx) {
+
+  if(executor == NULL || ctx == NULL)
+    return frost_err_invalid_parameter;
+
+  frost_errcode_t _result;
+
+  // count it first, the task may be taken before the push returns
+  atomic_fetch_add(&executor->pending, 1);
+
+  // the worker owns the bottom of its deque
+  if(__worker != NULL && __worker->executor == executor) {
+    _result = deque_push(__worker->deque, ctx);
+  }
+
+  else {
+    pthread_mutex_lock(&executor->lock);
+    _result = deque_push(executor->injector, ctx);
+    pthread_mutex_unlock(&executor->lock);
+  }
+
+  if(!frost_ok(_result)) {
+    atomic_fetch_sub(&executor->pending, 1);
+    return _result;
+  }
+
+  // wake a sleeping worker
+  if(atomic_load(&executor->sleepers) != 0) {
+    pthread_mutex_lock(&executor->lock);
+    pthread_cond_signal(&executor->cond);
+    pthread_mutex_unlock(&executor->lock);
+  }
+
+  return frost_err_ok;
+}
+
+frost_task_ctx_t* executor_context() {
+  return __worker_context;
+}
+
+bool executor_is_worker() {
+  return __worker != NULL;
+}
+
+frost_awaiter_t* executor_await(frost_awaiter_t* awaiter) {
+
+  if(awaiter == NULL)
+    return awaiter_from_value(NULL, frost_err_invalid_parameter);
+
+  uint64_t _start = __frost_time_tick(NULL);
+  while(!awaiter->is_finished) {
+
+    if(!__executor_help())
+      idle_yield();
+
+    // check if task timed out
+    if(awaiter->timeout != 0 && !awaiter->is_finished &&
+      (__frost_time_tick(NULL) - _start >= awaiter->timeout)) {
+
+      frost_log(TAG, "task timed out, force to break");
+      return awaiter_abandon(awaiter, frost_err_task_timeout);
+    }
+  }
+
+  return awaiter;
+}
+
+frost_errcode_t executor_sleep(size_t duration_ms) {
+
+  uint64_t _local_time = __frost_time_tick(NULL);
+
+  while(!(__frost_time_tick(NULL) - _local_time >= duration_ms)) {
+    if(!__executor_help())
+      idle_yield();
+  }
+
+  return frost_err_ok;
+}
+
+#else
+
+frost_errcode_t frost_executor_start(frost_engine_t* e, uint32_t workers) {
+  (void)e; (void)workers;
+  frost_log(TAG, "executor is not supported on this platform");
+  return frost_err_fatal_error;
+}
+
+frost_errcode_t frost_executor_stop(frost_engine_t* e) {
+  (void)e;
+  return frost_err_ok;
+}
+
+frost_errcode_t executor_submit(struct _frost_executor_t* executor, frost_task_ctx_t* ctx) {
+  (void)executor; (void)ctx;
+  return frost_err_fatal_error;
+}
+
+frost_task_ctx_t* executor_context() {
+  return NULL;
+}
+
+bool executor_is_worker() {
+  return false;
+}
+
+frost_awaiter_t* executor_await(frost_awaiter_t* awaiter) {
+  return awaiter;
+}
+
+frost_errcode_t executor_sleep(size_t duration_ms) {
+  (void)duration_ms;
+  return frost_err_ok;
+}
+
+#endif /* FROST_EXECUTOR_PTHREAD */
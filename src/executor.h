@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#ifndef _FROST_EXECUTOR_H
+#define _FROST_EXECUTOR_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "common.h"
+#include "engine.h"
+
+/**
+ * @brief initialize capacity of every worker deque, the deque grows automatically
+ */
+#ifndef FROST_EXECUTOR_DEQUE_SIZE
+  #define FROST_EXECUTOR_DEQUE_SIZE 256
+#endif
+
+/**
+ * @brief rounds an idle worker yields before it goes to sleep
+ */
+#ifndef FROST_EXECUTOR_SPIN
+  #define FROST_EXECUTOR_SPIN 64
+#endif
+
+/**
+ * @brief start the executor of an engine with worker threads.
+ * after started, the one-shot tasks of the engine run on the workers in parallel,
+ * every worker has its own deque and steals from the others when idle.
+ * the periodic tasks still run on the thread schedules the engine.
+ *
+ * the tasks run on workers must not use channels, and must be thread-safe
+ *
+ * @param e engine instance
+ * @param workers worker thread count, 0 uses the online cpu count
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t frost_executor_start(frost_engine_t* e, uint32_t workers);
+
+/**
+ * @brief stop the executor of an engine, wait for the running tasks and
+ * cancel the queued tasks. must not call from a worker
+ *
+ * @param e engine instance
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t frost_executor_stop(frost_engine_t* e);
+
+/**
+ * @brief submit an one-shot task to the executor. the worker pushes to its own deque,
+ * the other threads push to the shared injector
+ *
+ * @param executor executor
+ * @param ctx task context, owned by the executor after success
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t executor_submit(struct _frost_executor_t* executor, frost_task_ctx_t* ctx);
+
+/**
+ * @brief get the task running on current worker
+ *
+ * @return frost_task_ctx_t* NULL if current thread is not a worker
+ */
+frost_task_ctx_t* executor_context();
+
+/**
+ * @brief is current thread an executor worker
+ *
+ * @return bool
+ */
+bool executor_is_worker();
+
+/**
+ * @brief wait an awaiter on a worker, run the other tasks while waiting
+ *
+ * @param awaiter awaiter pointer
+ * @return frost_awaiter_t*
+ */
+frost_awaiter_t* executor_await(frost_awaiter_t* awaiter);
+
+/**
+ * @brief sleep (ms) on a worker, run the other tasks while sleeping
+ *
+ * @param duration_ms duration in millisecond
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t executor_sleep(size_t duration_ms);
+
+#endif /* _FROST_EXECUTOR_H */
@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+/* built-in high resolution time port, enabled by -DFROST_PORT_TIME_HIRES */
+
+#ifdef FROST_PORT_TIME_HIRES
+
+#ifndef _GNU_SOURCE
+  #define _GNU_SOURCE
+#endif
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "frost/port.h"
+
+#if defined(__x86_64__) && defined(__GNUC__)
+  #define FROST_HIRES_TSC
+  #include <cpuid.h>
+#endif
+
+#ifdef CLOCK_MONOTONIC_RAW
+  #define FROST_HIRES_CLOCK CLOCK_MONOTONIC_RAW
+#else
+  #define FROST_HIRES_CLOCK CLOCK_MONOTONIC
+#endif
+
+/**
+ * @brief calibration duration (ms) of the cycle counter
+ */
+#ifndef FROST_TIME_CALIBRATE_MS
+  #define FROST_TIME_CALIBRATE_MS 2
+#endif
+
+static struct {
+  bool use_tsc;
+  uint64_t tsc_base;
+  uint64_t ns_base;
+  uint64_t mult; /* ns per cycle, 32.32 fixed point */
+} hires = { 0 };
+
+/**
+ * MARK: __hires_clock_ns
+ * @brief read the monotonic clock in nanoseconds
+ */
+static uint64_t __hires_clock_ns() {
+  struct timespec _ts;
+  clock_gettime(FROST_HIRES_CLOCK, &_ts);
+  return (uint64_t)_ts.tv_sec * 1000000000ull + (uint64_t)_ts.tv_nsec;
+}
+
+#ifdef FROST_HIRES_TSC
+
+/**
+ * MARK: __hires_tsc_invariant
+ * @brief the cycle counter runs at a constant rate in all power states
+ */
+static bool __hires_tsc_invariant() {
+  unsigned int _eax, _ebx, _ecx, _edx;
+  if(!__get_cpuid(0x80000000, &_eax, &_ebx, &_ecx, &_edx) || _eax < 0x80000007)
+    return false;
+
+  __get_cpuid(0x80000007, &_eax, &_ebx, &_ecx, &_edx);
+  return (_edx & (1 << 8)) != 0;
+}
+
+#endif /* FROST_HIRES_TSC */
+
+/**
+ * MARK: __frost_time_calibrate
+ * @brief measure the cycle counter rate against the monotonic clock,
+ * fall back to the monotonic clock if the counter is not reliable
+ */
+void __frost_time_calibrate() {
+
+  hires.use_tsc = false;
+
+  #ifdef FROST_HIRES_TSC
+  if(!__hires_tsc_invariant())
+    return;
+
+  uint64_t _ns_start = __hires_clock_ns();
+  uint64_t _tsc_start = __builtin_ia32_rdtsc();
+  uint64_t _ns_end = _ns_start;
+  while(_ns_end - _ns_start < FROST_TIME_CALIBRATE_MS * 1000000ull) {
+    _ns_end = __hires_clock_ns();
+  }
+  uint64_t _tsc_end = __builtin_ia32_rdtsc();
+
+  if(_tsc_end <= _tsc_start)
+    return;
+
+  hires.mult = ((_ns_end - _ns_start) << 32) / (_tsc_end - _tsc_start);
+  hires.tsc_base = _tsc_end;
+  hires.ns_base = _ns_end;
+  hires.use_tsc = hires.mult != 0;
+  #endif
+}
+
+/**
+ * MARK: __frost_time_ns
+ * @brief get monotonic time in nanoseconds
+ */
+uint64_t __frost_time_ns() {
+
+  #ifdef FROST_HIRES_TSC
+  if(hires.use_tsc) {
+    uint64_t _cycles = __builtin_ia32_rdtsc() - hires.tsc_base;
+    return hires.ns_base + (uint64_t)(((unsigned __int128)_cycles * hires.mult) >> 32);
+  }
+  #endif
+
+  return __hires_clock_ns();
+}
+
+/**
+ * MARK: __frost_time_tick
+ * @brief get monotonic time in milliseconds
+ */
+uint64_t __frost_time_tick(uint64_t* tick) {
+  uint64_t _tick = __frost_time_ns() / 1000000ull;
+  if(tick) *tick = _tick;
+  return _tick;
+}
+
+#endif /* FROST_PORT_TIME_HIRES */
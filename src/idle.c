@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#include "log.h"
+#include "idle.h"
+
+#if defined(FROST_PORTED_IDLE_PARK)
+  #define FROST_IDLE_PORTED
+#elif defined(__linux__)
+  #define FROST_IDLE_EVENTFD
+  #include <sched.h>
+  #include <poll.h>
+  #include <unistd.h>
+  #include <sys/eventfd.h>
+#elif defined(__unix__) || defined(__APPLE__)
+  #define FROST_IDLE_PIPE
+  #include <sched.h>
+  #include <poll.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+#else
+  #warning "idle parking is not supported on this platform, \
+            frost_idle_park will fall back to busy spin. \
+            please port __frost_idle_park and __frost_idle_wake to support it."
+#endif
+
+#if defined(FROST_IDLE_EVENTFD) || defined(FROST_IDLE_PIPE)
+
+/**
+ * MARK: __idle_poll
+ * @brief wait the wakeup fd readable, and drain it
+ */
+static void __idle_poll(frost_idle_ctx_t* ctx, uint64_t timeout) {
+
+  struct pollfd _pfd = { .fd = ctx->fd[0], .events = POLLIN };
+  int _timeout = (timeout == FROST_IDLE_INFINITE || timeout > INT32_MAX) ? -1 : (int)timeout;
+
+  if(poll(&_pfd, 1, _timeout) <= 0)
+    return;
+
+  // drain the pending wakeups
+  uint64_t _value;
+  #ifdef FROST_IDLE_EVENTFD
+  (void)!read(ctx->fd[0], &_value, sizeof(_value));
+  #else
+  while(read(ctx->fd[0], &_value, sizeof(_value)) > 0);
+  #endif
+}
+
+#endif
+
+/**
+ * MARK: idle_create
+ * @brief create idle context
+ *
+ * @param ctx idle context
+ */
+frost_errcode_t idle_create(frost_idle_ctx_t* ctx) {
+
+  if(ctx == NULL)
+    return frost_err_invalid_parameter;
+
+  ctx->parked = false;
+  ctx->fd[0] = -1;
+  ctx->fd[1] = -1;
+
+  #if defined(FROST_IDLE_EVENTFD)
+  int _fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC); {
+    if(_fd < 0) return frost_err_fatal_error;
+    ctx->fd[0] = _fd;
+    ctx->fd[1] = _fd;
+  }
+
+  #elif defined(FROST_IDLE_PIPE)
+  if(pipe(ctx->fd) != 0)
+    return frost_err_fatal_error;
+
+  fcntl(ctx->fd[0], F_SETFL, O_NONBLOCK);
+  fcntl(ctx->fd[1], F_SETFL, O_NONBLOCK);
+  #endif
+
+  frost_log(TAG, "idle context created, wakeup fd %d", ctx->fd[0]);
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: idle_destroy
+ * @brief destroy idle context
+ *
+ * @param ctx idle context
+ */
+frost_errcode_t idle_destroy(frost_idle_ctx_t* ctx) {
+
+  if(ctx == NULL)
+    return frost_err_invalid_parameter;
+
+  #if defined(FROST_IDLE_EVENTFD)
+  if(ctx->fd[0] >= 0) close(ctx->fd[0]);
+
+  #elif defined(FROST_IDLE_PIPE)
+  if(ctx->fd[0] >= 0) close(ctx->fd[0]);
+  if(ctx->fd[1] >= 0) close(ctx->fd[1]);
+  #endif
+
+  ctx->fd[0] = -1;
+  ctx->fd[1] = -1;
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: idle_yield
+ * @brief give up current time slice
+ */
+void idle_yield() {
+  #if defined(FROST_IDLE_PORTED)
+  __frost_idle_park(0);
+  #elif defined(FROST_IDLE_EVENTFD) || defined(FROST_IDLE_PIPE)
+  sched_yield();
+  #endif
+}
+
+/**
+ * MARK: idle_park
+ * @brief park current thread until timeout or wakeup
+ *
+ * @param ctx idle context
+ * @param timeout timeout in milliseconds
+ */
+void idle_park(frost_idle_ctx_t* ctx, uint64_t timeout) {
+
+  ctx->parked = true; {
+    #if defined(FROST_IDLE_PORTED)
+    __frost_idle_park(timeout);
+    #elif defined(FROST_IDLE_EVENTFD) || defined(FROST_IDLE_PIPE)
+    __idle_poll(ctx, timeout);
+    #endif
+  }
+  ctx->parked = false;
+}
+
+/**
+ * MARK: idle_wake
+ * @brief wake up the parked thread
+ *
+ * @param ctx idle context
+ */
+void idle_wake(frost_idle_ctx_t* ctx) {
+
+  #if defined(FROST_IDLE_PORTED)
+  __frost_idle_wake();
+
+  #elif defined(FROST_IDLE_EVENTFD) || defined(FROST_IDLE_PIPE)
+  uint64_t _value = 1;
+  if(ctx->fd[1] >= 0) {
+    (void)!write(ctx->fd[1], &_value, sizeof(_value));
+  }
+  #endif
+}
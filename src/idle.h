@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#ifndef _FROST_IDLE_H
+#define _FROST_IDLE_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "common.h"
+
+/**
+ * @brief park forever
+ */
+#define FROST_IDLE_INFINITE UINT64_MAX
+
+/**
+ * @brief idle strategy when no task is due
+ */
+typedef enum {
+  frost_idle_spin,  /* busy spin, lowest wakeup latency */
+  frost_idle_yield, /* give up the time slice between passes */
+  frost_idle_park,  /* sleep until the next deadline or a wakeup */
+} frost_idle_t;
+
+typedef struct _frost_idle_ctx_t {
+  int fd[2]; /* wakeup fd, read end and write end */
+  FROST_ATOMIC(bool) parked;
+} frost_idle_ctx_t;
+
+/**
+ * @brief create idle context
+ *
+ * @param ctx idle context
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t idle_create(frost_idle_ctx_t* ctx);
+
+/**
+ * @brief destroy idle context
+ *
+ * @param ctx idle context
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t idle_destroy(frost_idle_ctx_t* ctx);
+
+/**
+ * @brief give up current time slice
+ */
+void idle_yield();
+
+/**
+ * @brief park current thread until timeout or wakeup
+ *
+ * @param ctx idle context
+ * @param timeout timeout in milliseconds, or FROST_IDLE_INFINITE
+ */
+void idle_park(frost_idle_ctx_t* ctx, uint64_t timeout);
+
+/**
+ * @brief wake up the parked thread. the wakeup is kept if the thread is not parked yet
+ *
+ * @param ctx idle context
+ */
+void idle_wake(frost_idle_ctx_t* ctx);
+
+#endif /* _FROST_IDLE_H */
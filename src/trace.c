@@ -0,0 +1,274 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include "common.h"
+#include "log.h"
+#include "trace.h"
+
+/**
+ * @brief one JSON line of the export, the longest event is far below it
+ */
+#define __TRACE_LINE_SIZE 256
+
+typedef struct {
+  char data[__TRACE_LINE_SIZE];
+  size_t length;
+} __trace_line_t;
+
+static const char* __trace_names[] = {
+  [frost_trace_pass_begin]    = "pass",
+  [frost_trace_pass_end]      = "pass",
+  [frost_trace_pass_dirty]    = "dirty",
+  [frost_trace_task_start]    = "task",
+  [frost_trace_task_end]      = "task",
+  [frost_trace_task_spawn]    = "spawn",
+  [frost_trace_task_delete]   = "delete",
+  [frost_trace_task_freeze]   = "freeze",
+  [frost_trace_task_unfreeze] = "unfreeze",
+  [frost_trace_chan_write]    = "chan write",
+  [frost_trace_chan_read]     = "chan read",
+};
+
+/**
+ * MARK: __trace_str
+ * @brief append a string
+ */
+static void __trace_str(__trace_line_t* line, const char* str) {
+  while(*str && line->length < __TRACE_LINE_SIZE) {
+    line->data[line->length++] = *str++;
+  }
+}
+
+/**
+ * MARK: __trace_u64
+ * @brief append a decimal number, zero padded to the width
+ */
+static void __trace_u64(__trace_line_t* line, uint64_t value, int width) {
+  char _digits[20];
+  int _count = 0;
+  do {
+    _digits[_count++] = (char)('0' + value % 10);
+    value /= 10;
+  } while(value != 0);
+
+  while(_count < width) _digits[_count++] = '0';
+  while(_count > 0 && line->length < __TRACE_LINE_SIZE) {
+    line->data[line->length++] = _digits[--_count];
+  }
+}
+
+/**
+ * MARK: __trace_ptr
+ * @brief append a pointer as a quoted hex string
+ */
+static void __trace_ptr(__trace_line_t* line, const void* ptr) {
+  char _text[2 + sizeof(uintptr_t) * 2 + 3] = "\"0x";
+  size_t _length = 3;
+  uintptr_t _value = (uintptr_t)ptr;
+  bool _leading = true;
+
+  for(int i = (int)sizeof(uintptr_t) * 2 - 1; i >= 0; --i) {
+    uint32_t _nibble = (uint32_t)(_value >> (i * 4)) & 0xf;
+    if(_leading && _nibble == 0 && i != 0) continue;
+    _leading = false;
+    _text[_length++] = "0123456789abcdef"[_nibble];
+  }
+
+  _text[_length++] = '"';
+  _text[_length] = '\0';
+  __trace_str(line, _text);
+}
+
+/**
+ * MARK: trace_create
+ * @brief create the event ring
+ *
+ * @param ctx trace context
+ * @param capacity events kept
+ */
+frost_errcode_t trace_create(frost_trace_ctx_t* ctx, size_t capacity) {
+
+  if(ctx == NULL || capacity == 0)
+    return frost_err_invalid_parameter;
+
+  size_t _capacity = 1;
+  while(_capacity < capacity) _capacity <<= 1;
+
+  frost_trace_event_t* _events = malloc(_capacity * sizeof(frost_trace_event_t)); {
+    if(_events == NULL)
+      return frost_err_out_of_memory;
+  }
+
+  ctx->events = _events;
+  ctx->mask = _capacity - 1;
+  ctx->count = 0;
+  ctx->enabled = false;
+
+  frost_log(TAG, "trace created %p, %zu events", ctx, _capacity);
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: trace_record
+ * @brief record an event
+ *
+ * @param ctx trace context
+ * @param type event type
+ * @param object the task
+ * @param detail event specific pointer
+ * @param arg event specific value
+ */
+void trace_record(frost_trace_ctx_t* ctx, frost_trace_type_t type, const void* object, const void* detail, uint32_t arg) {
+
+  frost_trace_event_t* _event = &ctx->events[ctx->count++ & ctx->mask];
+  _event->ns = __frost_time_ns();
+  _event->object = object;
+  _event->detail = detail;
+  _event->type = (uint32_t)type;
+  _event->arg = arg;
+}
+
+/**
+ * MARK: trace_export
+ * @brief convert the kept events to Chrome trace JSON
+ *
+ * @param ctx trace context
+ * @param writer called with every piece of the text
+ * @param user passed to the writer
+ */
+frost_errcode_t trace_export(frost_trace_ctx_t* ctx, frost_trace_writer_t writer, void* user) {
+
+  if(ctx == NULL || writer == NULL)
+    return frost_err_invalid_parameter;
+
+  if(ctx->events == NULL)
+    return frost_err_need_initialize;
+
+  const char* _head = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n"
+                      "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"frost\"}}";
+  writer(_head, strlen(_head), user);
+
+  uint64_t _first = ctx->count > ctx->mask + 1 ? ctx->count - (ctx->mask + 1) : 0;
+  uint64_t _base = ctx->count != 0 ? ctx->events[_first & ctx->mask].ns : 0;
+  uint32_t _depth = 0;
+
+  for(uint64_t i = _first; i < ctx->count; ++i) {
+    frost_trace_event_t* _event = &ctx->events[i & ctx->mask];
+    const char* _phase = "i";
+
+    // the slices nest in a pass, the ends lost their begins are skipped
+    switch(_event->type) {
+      case frost_trace_pass_begin:
+      case frost_trace_task_start:
+        _phase = "B";
+        ++_depth;
+        break;
+
+      case frost_trace_pass_end:
+      case frost_trace_task_end:
+        if(_depth == 0) continue;
+        _phase = "E";
+        --_depth;
+        break;
+    }
+
+    __trace_line_t _line = { .length = 0 };
+    uint64_t _ns = _event->ns - _base;
+
+    __trace_str(&_line, ",\n{\"name\":");
+    if(_event->type == frost_trace_task_start || _event->type == frost_trace_task_end)
+      __trace_ptr(&_line, _event->detail);
+    else {
+      __trace_str(&_line, "\"");
+      __trace_str(&_line, __trace_names[_event->type]);
+      __trace_str(&_line, "\"");
+    }
+
+    __trace_str(&_line, ",\"cat\":\"frost\",\"ph\":\"");
+    __trace_str(&_line, _phase);
+    __trace_str(&_line, "\",\"ts\":");
+    __trace_u64(&_line, _ns / 1000, 1);
+    __trace_str(&_line, ".");
+    __trace_u64(&_line, _ns % 1000, 3);
+    __trace_str(&_line, ",\"pid\":1,\"tid\":1");
+    if(*_phase == 'i') __trace_str(&_line, ",\"s\":\"t\"");
+
+    __trace_str(&_line, ",\"args\":{");
+    switch(_event->type) {
+      case frost_trace_pass_begin:
+      case frost_trace_pass_dirty:
+        break;
+
+      case frost_trace_pass_end:
+        __trace_str(&_line, "\"tasks\":");
+        __trace_u64(&_line, _event->arg, 1);
+        break;
+
+      case frost_trace_task_end:
+        __trace_str(&_line, "\"suspended\":");
+        __trace_u64(&_line, _event->arg, 1);
+        break;
+
+      case frost_trace_chan_write:
+      case frost_trace_chan_read:
+        __trace_str(&_line, "\"packs\":");
+        __trace_u64(&_line, _event->arg, 1);
+        __trace_str(&_line, ",");
+        /* fall through */
+      case frost_trace_task_unfreeze:
+        __trace_str(&_line, "\"chan\":");
+        __trace_ptr(&_line, _event->detail);
+        __trace_str(&_line, ",\"task\":");
+        __trace_ptr(&_line, _event->object);
+        break;
+
+      default:
+        __trace_str(&_line, "\"task\":");
+        __trace_ptr(&_line, _event->object);
+        if(_event->detail != NULL) {
+          __trace_str(&_line, ",\"callback\":");
+          __trace_ptr(&_line, _event->detail);
+        }
+        break;
+    }
+    __trace_str(&_line, "}}");
+
+    writer(_line.data, _line.length, user);
+  }
+
+  const char* _tail = "\n]}\n";
+  writer(_tail, strlen(_tail), user);
+
+  return frost_err_ok;
+}
+
+/**
+ * MARK: trace_destroy
+ * @brief destroy the event ring
+ *
+ * @param ctx trace context
+ */
+frost_errcode_t trace_destroy(frost_trace_ctx_t* ctx) {
+
+  if(ctx == NULL)
+    return frost_err_invalid_parameter;
+
+  free(ctx->events);
+  ctx->events = NULL;
+  ctx->mask = 0;
+  ctx->count = 0;
+  ctx->enabled = false;
+
+  return frost_err_ok;
+}
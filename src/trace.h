@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#ifndef _FROST_TRACE_H
+#define _FROST_TRACE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "common.h"
+
+/**
+ * @brief default trace events kept per engine, rounded up to a power of two
+ */
+#ifndef FROST_TRACE_SIZE
+  #define FROST_TRACE_SIZE 4096
+#endif
+
+/**
+ * @brief trace event types
+ */
+typedef enum {
+  frost_trace_pass_begin,
+  frost_trace_pass_end,      /* arg: the tasks run */
+  frost_trace_pass_dirty,    /* the pass aborted because the task list changed */
+  frost_trace_task_start,    /* detail: the callback */
+  frost_trace_task_end,      /* detail: the callback, arg: 1 if suspended */
+  frost_trace_task_spawn,    /* detail: the callback */
+  frost_trace_task_delete,   /* detail: the callback */
+  frost_trace_task_freeze,
+  frost_trace_task_unfreeze, /* detail: the channel woke it up, NULL if by flag */
+  frost_trace_chan_write,    /* object: the receiver, detail: the channel, arg: the packs */
+  frost_trace_chan_read,     /* detail: the channel, arg: the packs */
+} frost_trace_type_t;
+
+typedef struct _frost_trace_event_t {
+  uint64_t ns;
+  const void* object; /* the task */
+  const void* detail;
+  uint32_t type;
+  uint32_t arg;
+} frost_trace_event_t;
+
+typedef struct _frost_trace_ctx_t {
+  frost_trace_event_t* events; /* NULL if not started */
+  size_t mask;
+  uint64_t count; /* events recorded, the latest mask + 1 are kept */
+  bool enabled;
+} frost_trace_ctx_t;
+
+/**
+ * @brief output of the trace export
+ *
+ * @param data the text, not null-terminated
+ * @param length text length
+ * @param user the user data
+ */
+typedef void (* frost_trace_writer_t)(const char* data, size_t length, void* user);
+
+/**
+ * @brief record an event if the trace is enabled, the owner thread of engine only
+ */
+#define frost_trace(e, type, object, detail, arg) \
+  do { if((e)->trace.enabled) trace_record(&(e)->trace, type, object, detail, arg); } while(0)
+
+/**
+ * @brief create the event ring of a trace, the oldest events are overwritten when full
+ *
+ * @param ctx trace context
+ * @param capacity events kept, rounded up to a power of two
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t trace_create(frost_trace_ctx_t* ctx, size_t capacity);
+
+/**
+ * @brief record an event
+ *
+ * @param ctx trace context
+ * @param type event type
+ * @param object the task
+ * @param detail event specific pointer
+ * @param arg event specific value
+ */
+void trace_record(frost_trace_ctx_t* ctx, frost_trace_type_t type, const void* object, const void* detail, uint32_t arg);
+
+/**
+ * @brief convert the kept events to Chrome trace JSON, the oldest first.
+ * the timestamps are relative to the oldest event
+ *
+ * @param ctx trace context
+ * @param writer called with every piece of the text in order
+ * @param user passed to the writer
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t trace_export(frost_trace_ctx_t* ctx, frost_trace_writer_t writer, void* user);
+
+/**
+ * @brief destroy the event ring of a trace
+ *
+ * @param ctx trace context
+ * @return frost_errcode_t if success return ok
+ */
+frost_errcode_t trace_destroy(frost_trace_ctx_t* ctx);
+
+#endif /* _FROST_TRACE_H */
@@ -0,0 +1,35 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#ifndef _FROST_TESTAPI_H
+#define _FROST_TESTAPI_H
+
+#include <stdio.h>
+
+/**
+ * @brief result of a test item, every tests/<name>.c defines test_result_t <name>()
+ */
+typedef enum {
+  test_result_passed,
+  test_result_failed,
+  test_result_skipped, /* not supported on this platform */
+} test_result_t;
+
+/**
+ * @brief fail the test item if the expression is false
+ */
+#define TEST_ASSERT(expr) \
+  do { \
+    if(!(expr)) { \
+      printf("  %s:%d: assertion '%s' failed\n", __FILE__, __LINE__, #expr); \
+      return test_result_failed; \
+    } \
+  } while(0)
+
+#endif /* _FROST_TESTAPI_H */
@@ -13,10 +13,8 @@ int main() {
   frost_init();
   frost_task_interval(&__callback_test, 1000, NULL);
 
-  // initialization okay, run tasks
-  frost_errcode_t _result = frost_err_ok;
-  while (frost_ok(_result = frost_schedule_tasks())) {
-    // schedule the tasks
-  }
+  // initialization okay, run tasks,
+  // park the thread until the next deadline when nothing is due
+  frost_run(frost_idle_park);
 
 }
\ No newline at end of file
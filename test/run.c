@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#include <stdio.h>
+
+#include <test_table.h>
+
+int main() {
+
+  size_t _failed = 0;
+
+  // run every test item found by cmake, in the order of file names
+  for(size_t i = 0; i < TEST_SIZE; ++i) {
+    test_result_t _result = TEST_ITEMS[i].func();
+
+    if(_result == test_result_failed) ++_failed;
+    printf("[%s] %s\n", _result == test_result_passed ? "PASS" :
+                        _result == test_result_skipped ? "SKIP" : "FAIL", TEST_ITEMS[i].name);
+  }
+
+  printf("%zu of %zu test items failed\n", _failed, (size_t)TEST_SIZE);
+  return _failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,128 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#include <testapi.h>
+
+#include "common.h"
+#include "data/aring.h"
+
+#if defined(FROST_HAS_ATOMICS) && (defined(__unix__) || defined(__APPLE__))
+
+#include <pthread.h>
+#include <sched.h>
+
+#define PRODUCERS 4
+#define ITEMS 50000
+#define __ITEM(producer, seq) ((void *)(((uintptr_t)(producer) << 24) | ((uintptr_t)(seq) + 1)))
+
+static aring_ctx_t* __ring;
+
+static void* __producer(void* arg) {
+
+  uintptr_t _producer = (uintptr_t)arg;
+  for(uint32_t i = 0; i < ITEMS; ++i) {
+
+    // the ring is small, wait for the consumer when it's full
+    while(aring_push(__ring, __ITEM(_producer, i)) == frost_err_full)
+      sched_yield();
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief consume the items of producers, each arrives once and in the push order of its producer
+ */
+static test_result_t __consume(size_t producers) {
+
+  uint32_t _next[PRODUCERS] = { 0 };
+  size_t _popped = 0;
+
+  while(_popped < producers * ITEMS) {
+
+    void* _items[16];
+    size_t _count = 0;
+    if(!frost_ok(aring_pop_many(__ring, _items, 16, &_count))) {
+      sched_yield();
+      continue;
+    }
+
+    for(size_t i = 0; i < _count; ++i) {
+      uintptr_t _producer = (uintptr_t)_items[i] >> 24;
+      TEST_ASSERT(_producer < producers);
+      TEST_ASSERT(_items[i] == __ITEM(_producer, _next[_producer]));
+      ++_next[_producer];
+    }
+
+    _popped += _count;
+  }
+
+  return test_result_passed;
+}
+
+/**
+ * @brief the bounded ring rejects the push when full, and keeps the order
+ * with one producer or many producers running on the other threads
+ */
+test_result_t aring_concurrent() {
+
+  void* _item = NULL;
+
+  // the capacity is rounded up to power of two
+  TEST_ASSERT(frost_ok(aring_create(5, aring_spsc, &__ring)));
+  for(uint32_t i = 0; i < 8; ++i)
+    TEST_ASSERT(frost_ok(aring_push(__ring, __ITEM(0, i))));
+
+  TEST_ASSERT(aring_push(__ring, __ITEM(0, 8)) == frost_err_full);
+  TEST_ASSERT(aring_size(__ring) == 8);
+
+  for(uint32_t i = 0; i < 8; ++i)
+    TEST_ASSERT(frost_ok(aring_pop(__ring, &_item)) && _item == __ITEM(0, i));
+
+  TEST_ASSERT(aring_pop(__ring, &_item) == frost_err_eof);
+  TEST_ASSERT(aring_size(__ring) == 0);
+  aring_destroy(__ring);
+
+  // one producer thread without compare-and-swap
+  pthread_t _threads[PRODUCERS];
+  TEST_ASSERT(frost_ok(aring_create(64, aring_spsc, &__ring)));
+  TEST_ASSERT(pthread_create(&_threads[0], NULL, __producer, (void *)0) == 0);
+
+  // on failure the producer may wait for a full ring forever, leave it
+  test_result_t _result = __consume(1);
+  if(_result != test_result_passed)
+    return _result;
+
+  pthread_join(_threads[0], NULL);
+  aring_destroy(__ring);
+
+  // the producers race for the slots
+  TEST_ASSERT(frost_ok(aring_create(64, aring_mpsc, &__ring)));
+  for(uintptr_t i = 0; i < PRODUCERS; ++i)
+    TEST_ASSERT(pthread_create(&_threads[i], NULL, __producer, (void *)i) == 0);
+
+  if((_result = __consume(PRODUCERS)) != test_result_passed)
+    return _result;
+
+  for(size_t i = 0; i < PRODUCERS; ++i)
+    pthread_join(_threads[i], NULL);
+
+  TEST_ASSERT(aring_pop(__ring, &_item) == frost_err_eof);
+  aring_destroy(__ring);
+
+  return test_result_passed;
+}
+
+#else
+
+test_result_t aring_concurrent() {
+  return test_result_skipped;
+}
+
+#endif
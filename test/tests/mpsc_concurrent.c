@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#include <testapi.h>
+
+#include "common.h"
+#include "data/mpsc.h"
+
+#if defined(FROST_HAS_ATOMICS) && (defined(__unix__) || defined(__APPLE__))
+
+#include <pthread.h>
+#include <sched.h>
+
+#define PRODUCERS 4
+#define ITEMS 20000
+
+typedef struct {
+  mpsc_node_t node;
+  uint32_t producer;
+  uint32_t seq;
+} __item_t;
+
+static mpsc_ctx_t* __queue;
+static __item_t __items[PRODUCERS][ITEMS];
+
+static void* __producer(void* arg) {
+
+  uint32_t _producer = (uint32_t)(uintptr_t)arg;
+  for(uint32_t i = 0; i < ITEMS; ++i) {
+    __items[_producer][i].producer = _producer;
+    __items[_producer][i].seq = i;
+    mpsc_push(__queue, &__items[_producer][i].node, &__items[_producer][i]);
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief producers push at the same time, the consumer gets every node
+ * exactly once and in the push order of each producer
+ */
+test_result_t mpsc_concurrent() {
+
+  TEST_ASSERT(frost_ok(mpsc_create(&__queue)));
+
+  mpsc_node_t* _node = NULL;
+  TEST_ASSERT(mpsc_is_empty(__queue));
+  TEST_ASSERT(mpsc_pop(__queue, &_node) == frost_err_eof);
+
+  pthread_t _threads[PRODUCERS];
+  for(uintptr_t i = 0; i < PRODUCERS; ++i)
+    TEST_ASSERT(pthread_create(&_threads[i], NULL, __producer, (void *)i) == 0);
+
+  uint32_t _next[PRODUCERS] = { 0 };
+  size_t _popped = 0;
+
+  while(_popped < PRODUCERS * ITEMS) {
+
+    // a node being pushed is not visible yet, try again
+    if(!frost_ok(mpsc_pop(__queue, &_node))) {
+      sched_yield();
+      continue;
+    }
+
+    __item_t* _item = (__item_t *)_node->data;
+    TEST_ASSERT(_node == &_item->node);
+    TEST_ASSERT(_item->seq == _next[_item->producer]);
+
+    ++_next[_item->producer];
+    ++_popped;
+  }
+
+  for(size_t i = 0; i < PRODUCERS; ++i)
+    pthread_join(_threads[i], NULL);
+
+  TEST_ASSERT(mpsc_is_empty(__queue));
+  TEST_ASSERT(mpsc_pop(__queue, &_node) == frost_err_eof);
+
+  // the stub is recycled, the queue keeps working after drained
+  TEST_ASSERT(frost_ok(mpsc_push(__queue, &__items[0][0].node, &__items[0][0])));
+  TEST_ASSERT(frost_ok(mpsc_pop(__queue, &_node)) && _node == &__items[0][0].node);
+  TEST_ASSERT(mpsc_is_empty(__queue));
+
+  mpsc_destroy(__queue);
+  return test_result_passed;
+}
+
+#else
+
+test_result_t mpsc_concurrent() {
+  return test_result_skipped;
+}
+
+#endif
@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#include <string.h>
+
+#include <testapi.h>
+
+#include "common.h"
+#include "data/pool.h"
+
+#if defined(FROST_HAS_ATOMICS) && (defined(__unix__) || defined(__APPLE__))
+
+#include <pthread.h>
+
+#define FREERS 4
+#define BLOCKS 2048
+
+static pool_ctx_t* __pool;
+static pool_ctx_t* __foreign[FREERS];
+static uint8_t* __blocks[BLOCKS];
+
+/**
+ * @brief the size of block i, spread over the size classes
+ */
+static size_t __size(size_t i) {
+  return 8 + (i % 5) * 50;
+}
+
+static void* __freer(void* arg) {
+
+  size_t _freer = (size_t)(uintptr_t)arg;
+
+  // a foreign pool gives the block back to its owner, not caching it
+  pool_create(0, 1024, BLOCKS, &__foreign[_freer]);
+
+  for(size_t i = _freer; i < BLOCKS; i += FREERS)
+    pool_free(_freer % 2 ? __foreign[_freer] : NULL, __blocks[i]);
+
+  return NULL;
+}
+
+/**
+ * @brief the other threads free the blocks of a pool, the owner takes them back
+ * from its remote stacks and reuses them without malloc
+ */
+test_result_t pool_remote_free() {
+
+  pool_stats_t _stats;
+
+  TEST_ASSERT(frost_ok(pool_create(0, 1024, BLOCKS, &__pool)));
+
+  for(size_t i = 0; i < BLOCKS; ++i) {
+    TEST_ASSERT(frost_ok(pool_alloc(__pool, __size(i), (void **)&__blocks[i])));
+    memset(__blocks[i], (int)(i & 0xFF), __size(i));
+  }
+
+  TEST_ASSERT(frost_ok(pool_get_stats(__pool, &_stats)));
+  TEST_ASSERT(_stats.miss == BLOCKS && _stats.hit == 0);
+
+  pthread_t _threads[FREERS];
+  for(uintptr_t i = 0; i < FREERS; ++i)
+    TEST_ASSERT(pthread_create(&_threads[i], NULL, __freer, (void *)i) == 0);
+
+  for(size_t i = 0; i < FREERS; ++i)
+    pthread_join(_threads[i], NULL);
+
+  // the foreign pools own none of them
+  for(size_t i = 0; i < FREERS; ++i) {
+    TEST_ASSERT(frost_ok(pool_get_stats(__foreign[i], &_stats)));
+    TEST_ASSERT(_stats.cached == 0);
+    pool_destroy(__foreign[i]);
+  }
+
+  // all of them come back, no block is handed out twice
+  for(size_t i = 0; i < BLOCKS; ++i) {
+    TEST_ASSERT(frost_ok(pool_alloc(__pool, __size(i), (void **)&__blocks[i])));
+    memset(__blocks[i], 0xEE, __size(i));
+  }
+
+  TEST_ASSERT(frost_ok(pool_get_stats(__pool, &_stats)));
+  TEST_ASSERT(_stats.miss == BLOCKS && _stats.hit == BLOCKS);
+
+  for(size_t i = 0; i < BLOCKS; ++i) {
+    for(size_t k = 0; k < __size(i); ++k)
+      TEST_ASSERT(__blocks[i][k] == 0xEE);
+    pool_free(__pool, __blocks[i]);
+  }
+
+  pool_destroy(__pool);
+  return test_result_passed;
+}
+
+#else
+
+test_result_t pool_remote_free() {
+  return test_result_skipped;
+}
+
+#endif
@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#include <testapi.h>
+
+#include "common.h"
+#include "data/slab.h"
+
+#if defined(FROST_HAS_ATOMICS) && (defined(__unix__) || defined(__APPLE__))
+
+#include <pthread.h>
+
+#define FREERS 4
+#define OBJECTS 4096
+#define PER_CHUNK 64
+#define LIVE 0xA11CEu
+
+typedef struct {
+  void* link; /* overwritten by the freelist */
+  uint32_t live; /* LIVE while handed out, a new chunk is not cleared */
+} __object_t;
+
+static slab_ctx_t* __slab;
+static __object_t* __objects[OBJECTS];
+
+static void* __freer(void* arg) {
+
+  size_t _freer = (size_t)(uintptr_t)arg;
+  for(size_t i = _freer; i < OBJECTS; i += FREERS) {
+    __objects[i]->live = 0;
+    slab_free_remote(__slab, __objects[i]);
+  }
+
+  return NULL;
+}
+
+/**
+ * @brief the other threads free while the owner allocates, no object is handed out
+ * twice, and the owner reuses all of them without growing
+ */
+test_result_t slab_remote_free() {
+
+  TEST_ASSERT(frost_ok(slab_create(sizeof(__object_t), PER_CHUNK, &__slab)));
+
+  for(size_t i = 0; i < OBJECTS; ++i) {
+    TEST_ASSERT(frost_ok(slab_alloc(__slab, (void **)&__objects[i])));
+    __objects[i]->live = LIVE;
+  }
+
+  TEST_ASSERT(__slab->capacity == OBJECTS);
+
+  pthread_t _threads[FREERS];
+  for(uintptr_t i = 0; i < FREERS; ++i)
+    TEST_ASSERT(pthread_create(&_threads[i], NULL, __freer, (void *)i) == 0);
+
+  // races with the remote frees, takes them back or grows
+  static __object_t* _owned[OBJECTS];
+  for(size_t i = 0; i < OBJECTS; ++i) {
+    TEST_ASSERT(frost_ok(slab_alloc(__slab, (void **)&_owned[i])));
+    TEST_ASSERT(_owned[i]->live != LIVE);
+    _owned[i]->live = LIVE;
+  }
+
+  for(size_t i = 0; i < FREERS; ++i)
+    pthread_join(_threads[i], NULL);
+
+  size_t _capacity = __slab->capacity;
+  TEST_ASSERT(_capacity <= OBJECTS * 2);
+
+  for(size_t i = 0; i < OBJECTS; ++i) {
+    _owned[i]->live = 0;
+    TEST_ASSERT(frost_ok(slab_free(__slab, _owned[i])));
+  }
+
+  // every object is free, local or remote, allocating all of them does not grow
+  for(size_t i = 0; i < _capacity; ++i) {
+    __object_t* _object = NULL;
+    TEST_ASSERT(frost_ok(slab_alloc(__slab, (void **)&_object)));
+    TEST_ASSERT(_object->live != LIVE);
+    _object->live = LIVE;
+  }
+
+  TEST_ASSERT(__slab->capacity == _capacity);
+
+  slab_destroy(__slab);
+  return test_result_passed;
+}
+
+#else
+
+test_result_t slab_remote_free() {
+  return test_result_skipped;
+}
+
+#endif
@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: MIT
+/*******************************************************************************
+ * This file is the part of the Frost library
+ *
+ * (C) Copyright 2025 TheSnowfield.
+ *
+ * Authors: TheSnowfield <17957399+TheSnowfield@users.noreply.github.com>
+ ****************************************************************************/
+
+#include <stdlib.h>
+
+#include <testapi.h>
+
+#include "common.h"
+#include "data/wheel.h"
+
+#define NODES 2000
+#define ROUNDS 3000
+
+static wheel_node_t __nodes[NODES];
+static bool __fired[NODES];
+
+/**
+ * @brief the earliest pending expiry, UINT64_MAX if nothing pending
+ */
+static uint64_t __earliest() {
+
+  uint64_t _earliest = UINT64_MAX;
+  for(size_t i = 0; i < NODES; ++i) {
+    if(wheel_is_pending(&__nodes[i]) && __nodes[i].expires < _earliest)
+      _earliest = __nodes[i].expires;
+  }
+
+  return _earliest;
+}
+
+/**
+ * @brief add, delete and advance at random, near and far timers mixed.
+ * a timer fires at the first advance reaching its expiry, never before,
+ * and the next expiry never passes the earliest pending timer
+ */
+test_result_t wheel_random() {
+
+  wheel_ctx_t* _wheel = NULL;
+  uint64_t _now = 12345;
+
+  srand(7);
+  TEST_ASSERT(frost_ok(wheel_create(_now, &_wheel)));
+
+  for(size_t round = 0; round < ROUNDS; ++round) {
+
+    size_t i = (size_t)rand() % NODES;
+    if(!wheel_is_pending(&__nodes[i]) && !__fired[i]) {
+
+      // a quarter of them are beyond the range of the wheel
+      uint64_t _delay = (rand() % 4 == 0) ? (uint64_t)rand() % (1u << 26) : (uint64_t)rand() % 5000;
+      __nodes[i].data = &__fired[i];
+      TEST_ASSERT(frost_ok(wheel_add(_wheel, &__nodes[i], _now + _delay)));
+    }
+    else if(wheel_is_pending(&__nodes[i]) && rand() % 5 == 0) {
+      TEST_ASSERT(frost_ok(wheel_delete(_wheel, &__nodes[i])));
+      TEST_ASSERT(!wheel_is_pending(&__nodes[i]));
+    }
+
+    uint64_t _expires = 0;
+    uint64_t _earliest = __earliest();
+    if(_earliest == UINT64_MAX)
+      TEST_ASSERT(wheel_next_expiry(_wheel, &_expires) == frost_err_eof);
+    else {
+      TEST_ASSERT(frost_ok(wheel_next_expiry(_wheel, &_expires)));
+      TEST_ASSERT(_expires <= _earliest);
+    }
+
+    // small steps mostly, sometimes a long idle
+    _now += (rand() % 10 == 0) ? (uint64_t)rand() % (1u << 24) : (uint64_t)rand() % 200;
+
+    wheel_node_t* _expired = NULL;
+    TEST_ASSERT(frost_ok(wheel_advance(_wheel, _now, &_expired)));
+
+    for(wheel_node_t* _node = _expired; _node != NULL; _node = _node->next) {
+      TEST_ASSERT(_node->expires <= _now);
+      *(bool *)_node->data = true;
+    }
+
+    for(size_t k = 0; k < NODES; ++k) {
+      if(wheel_is_pending(&__nodes[k]))
+        TEST_ASSERT(__nodes[k].expires > _now);
+
+      // let some of them be added again
+      if(__fired[k] && rand() % 3 == 0)
+        __fired[k] = false;
+    }
+  }
+
+  // a long idle with a few far timers, each fires within the step reaching it
+  wheel_node_t _far[4] = { 0 };
+  for(size_t i = 0; i < 4; ++i)
+    TEST_ASSERT(frost_ok(wheel_add(_wheel, &_far[i], _now + 5000000 + i * 1000000)));
+
+  size_t _hits = 0;
+  for(uint64_t _tick = _now; _tick < _now + 10000000; _tick += 1000) {
+
+    wheel_node_t* _expired = NULL;
+    TEST_ASSERT(frost_ok(wheel_advance(_wheel, _tick, &_expired)));
+
+    for(wheel_node_t* _node = _expired; _node != NULL; _node = _node->next) {
+      TEST_ASSERT(_node->expires <= _tick && _node->expires + 1000 > _tick);
+      ++_hits;
+    }
+  }
+
+  TEST_ASSERT(_hits >= 4);
+  wheel_destroy(_wheel);
+
+  return test_result_passed;
+}